@@ -15,6 +15,12 @@
  * Includes
  ***********************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
+#include "DataloggerCfg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 /************************************************************************************
  * Defines
@@ -36,6 +42,79 @@
 #error NUMBER_OF_CONFIGS must be smaller than MAX_NUM_CONFIGS
 #endif
 
+#if DATALOGGER_CAPTURE_BUFFERS < 1 || DATALOGGER_CAPTURE_BUFFERS > 2
+#error DATALOGGER_CAPTURE_BUFFERS must be 1 or 2
+#endif
+
+#if DATALOGGER_MAX_TIMEBASES < 1 || DATALOGGER_MAX_TIMEBASES > 8
+#error DATALOGGER_MAX_TIMEBASES must be within 1 - 8
+#endif
+
+/** Block CRCs per capture buffer: Every channel starts a new block */
+#if DATALOGGER_CRC_BLOCK_SIZE
+#define DATALOGGER_CRC_MAX_BLOCKS   (DATALOGGER_MAX_BUFFER_SIZE / DATALOGGER_CRC_BLOCK_SIZE + MAX_NUM_LOGS)
+#else
+#define DATALOGGER_CRC_MAX_BLOCKS   1
+#endif
+
+/** Memory barrier of the guarded variable protocol, may be replaced by the 
+ *  barrier instruction of the target (e.g. __DMB() on Cortex-M) */
+#ifndef DATALOGGER_MEMORY_BARRIER
+#if defined(__GNUC__)
+#define DATALOGGER_MEMORY_BARRIER()     __sync_synchronize()
+#elif !DATALOGGER_CONSISTENT_READ
+#define DATALOGGER_MEMORY_BARRIER()     do { } while (0)
+#else
+#error DATALOGGER_MEMORY_BARRIER has to be defined for this compiler
+#endif
+#endif
+
+/** Atomic clear of bits in a byte, used by services which may preempt each other
+ *  (timebases). Built on DATALOGGER_CRITICAL_ENTER/EXIT if the configuration 
+ *  defines them, on the GCC atomic builtins otherwise. */
+#ifndef DATALOGGER_ATOMIC_CLEAR8
+#if defined(DATALOGGER_CRITICAL_ENTER)
+#define DATALOGGER_ATOMIC_CLEAR8(pui8Var, ui8Bits)  do { DATALOGGER_CRITICAL_ENTER(); *(pui8Var) &= (uint8_t)~(ui8Bits); DATALOGGER_CRITICAL_EXIT(); } while (0)
+#elif defined(__GNUC__)
+#define DATALOGGER_ATOMIC_CLEAR8(pui8Var, ui8Bits)  __atomic_fetch_and((pui8Var), (uint8_t)~(ui8Bits), __ATOMIC_RELAXED)
+#else
+#error DATALOGGER_CRITICAL_ENTER/EXIT have to be defined for this compiler
+#endif
+#endif
+#ifndef DATALOGGER_ATOMIC_SET8
+#if defined(DATALOGGER_CRITICAL_ENTER)
+#define DATALOGGER_ATOMIC_SET8(pui8Var, ui8Bits)    do { DATALOGGER_CRITICAL_ENTER(); *(pui8Var) |= (uint8_t)(ui8Bits); DATALOGGER_CRITICAL_EXIT(); } while (0)
+#elif defined(__GNUC__)
+#define DATALOGGER_ATOMIC_SET8(pui8Var, ui8Bits)    __atomic_fetch_or((pui8Var), (uint8_t)(ui8Bits), __ATOMIC_RELEASE)
+#else
+#error DATALOGGER_CRITICAL_ENTER/EXIT have to be defined for this compiler
+#endif
+#endif
+
+/** Publication of the committed sample counts: The service stores with release
+ *  semantics after the samples are written, readers load with acquire semantics
+ *  before they access the samples. Aligned 32 bit accesses are single-copy 
+ *  atomic, only the ordering has to be provided (e.g. __DMB() on Cortex-M). */
+#ifndef DATALOGGER_ATOMIC_STORE32
+#if defined(__GNUC__)
+#define DATALOGGER_ATOMIC_STORE32(pui32Var, ui32Val)    __atomic_store_n((pui32Var), (uint32_t)(ui32Val), __ATOMIC_RELEASE)
+#else
+#error DATALOGGER_ATOMIC_STORE32 has to be defined for this compiler
+#endif
+#endif
+#ifndef DATALOGGER_ATOMIC_LOAD32
+#if defined(__GNUC__)
+#define DATALOGGER_ATOMIC_LOAD32(pui32Var)              __atomic_load_n((pui32Var), __ATOMIC_ACQUIRE)
+#else
+#error DATALOGGER_ATOMIC_LOAD32 has to be defined for this compiler
+#endif
+#endif
+
+/** Writer side of a guarded variable: The sequence counter is odd while the 
+ *  variable is written. pui32Seq is the counter passed to DataloggerSetChannelGuard. */
+#define DATALOGGER_GUARD_WRITE_BEGIN(pui32Seq)  do { (*(pui32Seq))++; DATALOGGER_MEMORY_BARRIER(); } while (0)
+#define DATALOGGER_GUARD_WRITE_END(pui32Seq)    do { DATALOGGER_MEMORY_BARRIER(); (*(pui32Seq))++; } while (0)
+
 /************************************************************************************
  * Enum Type definitions
  ***********************************************************************************/
@@ -58,7 +137,8 @@ typedef enum
 {
     eOPMODE_RECMODERAM  = 0,
     eOPMODE_RECMODEMEM  = 1,
-    eOPMODE_LIVE        = 2 
+    eOPMODE_LIVE        = 2,
+    eOPMODE_REPLAY      = 3     /*!< Writes recorded samples back into the channel variables */
 }tDATALOG_OPMODES;
 
 typedef enum
@@ -72,9 +152,48 @@ typedef enum
     eDATALOG_ERROR_NOT_ENOUGH_MEMORY        = 6,
     eDATALOG_ERROR_MEMORY_ALLOCATION_FAILED = 7,
     eDATALOG_ERROR_NO_DATA                  = 8,
-    eDATALOG_ERROR_NOT_IMPLEMENTED          = 9
+    eDATALOG_ERROR_NOT_IMPLEMENTED          = 9,
+    eDATALOG_ERROR_INVALID_PARAMETER        = 10,
+    eDATALOG_ERROR_BUFFER_LOCKED            = 11,
+    eDATALOG_ERROR_IO                       = 12,
+    eDATALOG_ERROR_CRC                      = 13
 }tDATALOG_ERROR;
 
+typedef enum
+{
+    eSEQMODE_IMMEDIATE  = 0,    /*!< Next segment starts right after the last one */
+    eSEQMODE_TRIGGERED  = 1,    /*!< Every segment waits for DataloggerTrigger */
+    eSEQMODE_RING       = 2     /*!< Single segment overwritten until the datalogger is stopped */
+}tDATALOG_SEQMODE;
+
+typedef enum
+{
+    eDATALOG_ENCODING_BE        = 0,    /*!< Byte aligned samples, big endian */
+    eDATALOG_ENCODING_BITPACKED = 1,    /*!< Bit stream (MSB first) of ui8BitWidth bit samples */
+    eDATALOG_ENCODING_NATIVE    = 2     /*!< Byte aligned samples, byte order of the target (gather mode) */
+}tDATALOG_ENCODING;
+
+typedef enum
+{
+    eDATALOG_TYPE_UINT  = 0,    /*!< Unsigned integer */
+    eDATALOG_TYPE_INT   = 1,    /*!< Two's complement signed integer */
+    eDATALOG_TYPE_FLOAT = 2     /*!< IEEE 754 float (4 bytes) or double (8 bytes) */
+}tDATALOG_DATATYPE;
+
+typedef enum
+{
+    eSIZING_EQUAL_TIME  = 0,    /*!< All channels cover the same time span */
+    eSIZING_WEIGHTED    = 1     /*!< Memory is shared according to channel weights */
+}tDATALOG_SIZING;
+
+typedef enum
+{
+    eDATALOG_CHKIND_PLAIN       = 0,    /*!< Byte aligned variable */
+    eDATALOG_CHKIND_BIT         = 1,    /*!< Bits of a variable (DataloggerRegisterBitLog) */
+    eDATALOG_CHKIND_GETTER      = 2,    /*!< Value of a getter (DataloggerRegisterGetterLog) */
+    eDATALOG_CHKIND_HISTOGRAM   = 3     /*!< Bin counts (DataloggerRegisterHistogramLog) */
+}tDATALOG_CHANNEL_KIND;
+
 /************************************************************************************
  * Structure type definitions
  ***********************************************************************************/
@@ -86,6 +205,14 @@ typedef struct
     uint8_t ui8Revision;
 }tDATALOGGER_VERSION;
 
+/** @brief Memory budget of the registered channels */
+typedef struct
+{
+    uint32_t    ui32Capacity;           /*!< Capture memory available.*/
+    uint32_t    ui32Required;           /*!< Memory required by the registered channels.*/
+    int32_t     i32Remaining;           /*!< Free memory, negative if the configuration doesn't fit.*/
+}tDATALOG_BUDGET;
+
 /************************************************************************************
  * Datalog control data
  ***********************************************************************************/
@@ -99,6 +226,21 @@ typedef struct
 
 #define tDATALOGGER_CALLBACKS_DEFAULTS {NULL, NULL}
 
+/** @brief Getter of getter channels. Called once per service tick for all due 
+ *  channels sharing the getter and its context. Writes the raw value of every 
+ *  channel in ui8Channels (bit 0: log number 1) to pui64Values[log number - 1]. */
+typedef void (*tDATALOG_GETTER)(uint8_t ui8Channels, uint64_t *pui64Values, void *pvCtx);
+
+/** @brief Scaling of the raw samples into engineering units (value = raw * gain + offset) */
+typedef struct
+{
+    tDATALOG_DATATYPE   eType;      /*!< Data type of the raw samples.*/
+    float               fGain;      /*!< Gain factor.*/
+    float               fOffset;    /*!< Offset added after the gain.*/
+}tDATALOG_SCALING;
+
+#define tDATALOG_SCALING_DEFAULTS {eDATALOG_TYPE_UINT, 1.0f, 0.0f}
+
 /** @brief Datalog channel data structure */
 typedef struct
 {
@@ -109,6 +251,10 @@ typedef struct
     uint32_t    ui32RecordLength;       /*!< Record length of the channel */
     uint8_t    *pui8Variable;           /*!< Memory address of the target variable.*/
     uint8_t     ui8ByteCount;           /*!< Byte count of the variable.*/
+    tDATALOG_SCALING sScaling;          /*!< Data type and scaling of the variable.*/
+    uint32_t    ui32BitMask;            /*!< Captured bits of bit channels (0: byte aligned channel).*/
+    uint8_t     ui8BitWidth;            /*!< Bits per sample of bit channels.*/
+    uint8_t     ui8MaskShift;           /*!< Shift of a contiguous bit mask, 0xFF if not contiguous.*/
     // Channel parameter variables
     uint16_t    ui16RetrieveThreshIdx; /*!< Retrieve threshold index of this channel*/
     // Channel state variables
@@ -119,9 +265,39 @@ typedef struct
     uint16_t    ui16DivideCount;        /*!< Count for the frequency divider*/
     // RAM buffer for this channel
     uint8_t*    ui8RamBuf[2]; 
+    // Sequence mode
+    uint32_t    ui32SegmentLength;      /*!< Record length of one segment*/
+    uint32_t    ui32SegmentEnd;         /*!< Record count at which the current segment ends*/
+    // Bit packer state
+    uint64_t    ui64BitAcc;             /*!< Bits not yet written to the buffer*/
+    uint8_t     ui8BitFill;             /*!< Number of valid bits in ui64BitAcc*/
+    // Consistent read
+    const volatile uint32_t *pui32Guard;/*!< Sequence counter of a guarded variable (NULL: unguarded).*/
+    uint64_t    ui64LastValue;          /*!< Last consistent value of a guarded variable, value of a getter channel.*/
+    // Getter channels
+    tDATALOG_GETTER pfnGetter;          /*!< Getter of the value (NULL: pui8Variable is sampled).*/
+    void        *pvGetterCtx;           /*!< Context of the getter.*/
+    // Runtime rate changes
+    uint16_t    ui16PendingDivider;     /*!< Divider applied with the next tick, 0: stop the channel.*/
+    // Histogram channels
+    uint8_t     ui8HistByteCount;       /*!< Byte count of the variable (0: no histogram channel).*/
+    uint8_t     ui8HistSigned;          /*!< Variable is signed.*/
+    uint8_t     ui8HistShift;           /*!< Bin width is 2^ui8HistShift.*/
+    int32_t     i32HistMin;             /*!< Lower bound of the first bin.*/
+    // Decimation filter
+    uint8_t     ui8CicOrder;            /*!< Order of the CIC decimator (0: plain divider).*/
+    uint8_t     ui8CicWarmup;           /*!< Outputs until the filter has settled.*/
+    uint64_t    ui64CicInteg[DATALOGGER_CIC_MAX_ORDER]; /*!< Integrators (input rate).*/
+    uint64_t    ui64CicComb[DATALOGGER_CIC_MAX_ORDER];  /*!< Comb delays (output rate).*/
+    // Progressive readout
+    uint32_t    ui32CommittedCount;     /*!< Samples completely written to the capture buffer.*/
+    // Block CRCs
+    uint32_t    ui32Crc;                /*!< CRC of the current block so far.*/
+    uint32_t    ui32CrcPos;             /*!< Bytes covered by the block CRCs.*/
+    uint16_t    ui16CrcFirstBlock;      /*!< Index of the first block of the channel.*/
 }tDATALOG_CHANNEL;
 
-#define tDATALOG_CHANNEL_DEFAULTS {0, 0, 0, 0, NULL, 0, 0, 0, 0, 0, 0, 1, {NULL}}
+#define tDATALOG_CHANNEL_DEFAULTS {0, 0, 0, 0, NULL, 0, tDATALOG_SCALING_DEFAULTS, 0, 0, 0, 0, 0, 0, 0, 0, 1, {NULL}, 0, 0, 0, 0, NULL, 0, NULL, NULL, 0, 0, 0, 0, 0, 0, 0, {0}, {0}, 0, 0, 0, 0}
 // #define tDATALOG_CHANNEL_DEFAULTS {0}
 
 /** @brief Datalog control structure */
@@ -132,13 +308,129 @@ typedef struct
     uint8_t             ui8MemoryAcquired;
     uint8_t             ui8ChannelsRunning;
     uint32_t            ui32MemLen;
-    uint8_t             *pui8Data;
+    uint32_t            ui32MemCapacity;                            /*!< Allocated size of each capture buffer.*/
+    uint8_t             ui8LayoutDirty;                             /*!< Channels whose memory size changed since the last initialization.*/
+    uint8_t             ui8GetterChannels;                          /*!< Channels sampled by a getter.*/
+    uint8_t             ui8ChannelsStopped;                         /*!< Channels stopped for the rest of the run.*/
+    uint8_t             ui8RateChanges;                             /*!< Channels with a pending rate change.*/
+    uint8_t             ui8RingWrapped;                             /*!< Ring channels which have overwritten their oldest samples.*/
+    uint8_t             *pui8Data;                                  /*!< Buffer the current run records into.*/
+    uint8_t             *pui8CaptureBuf[DATALOGGER_CAPTURE_BUFFERS];/*!< Allocated capture buffers.*/
+    uint8_t             ui8CaptureBufIdx;                           /*!< Index of the recording buffer.*/
+    uint8_t             *pui8ReadoutData;                           /*!< Last completed capture.*/
+    uint8_t             ui8ReadoutBufIdx;                           /*!< Index of the readout buffer.*/
+    uint32_t            ui32ReadoutCount[MAX_NUM_LOGS];             /*!< Sample counts of the readout buffer.*/
+    uint8_t             ui8ReadoutLocks;                            /*!< Locked capture buffers (bit mask).*/
+    uint32_t            ui32TickCount;                              /*!< Service ticks since start.*/
     tDATALOG_CHANNEL    sDatalogChannels[MAX_NUM_LOGS];
 }tDATALOG_CONTROL;
 
-#define tDATALOG_CONTROL_DEFAULTS {eOPMODE_RECMODERAM, 0, 0, 0, 0, NULL, {tDATALOG_CHANNEL_DEFAULTS}}
+#define tDATALOG_CONTROL_DEFAULTS {eOPMODE_RECMODERAM, 0, 0, 0, 0, 0, 0xFF, 0, 0, 0, 0, NULL, {NULL}, 0, NULL, 0, {0}, 0, 0, {tDATALOG_CHANNEL_DEFAULTS}}
+
+/** @brief Zero-copy view on the recorded samples of one channel */
+typedef struct
+{
+    const uint8_t      *pui8Base;       /*!< First sample of the channel.*/
+    uint32_t            ui32Count;      /*!< Number of recorded samples.*/
+    uint16_t            ui16Stride;     /*!< Byte distance of two consecutive samples.*/
+    uint8_t             ui8Width;       /*!< Byte count of one sample.*/
+    uint8_t             ui8BitWidth;    /*!< Bits per sample of bit packed channels.*/
+    tDATALOG_ENCODING   eEncoding;      /*!< Encoding of the samples.*/
+}tDATALOG_CHANNEL_VIEW;
+
+#define tDATALOG_CHANNEL_VIEW_DEFAULTS {NULL, 0, 0, 0, 0, eDATALOG_ENCODING_BE}
+
+/** Address of sample ui32Idx of a byte aligned channel view (ui16Stride = 0 for bit 
+ *  packed channels, use DataloggerViewGetSample) */
+#define DATALOGGER_VIEW_SAMPLE_PTR(pView, ui32Idx) \
+    ((pView)->pui8Base + (uint32_t)(ui32Idx) * (pView)->ui16Stride)
+
+/************************************************************************************
+ * Sequence mode
+ ***********************************************************************************/
+/** @brief Descriptor of one recorded segment */
+typedef struct
+{
+    uint16_t    ui16SegmentIdx;         /*!< Index of the segment within the run.*/
+    uint32_t    ui32StartTick;          /*!< Service tick of the first sample.*/
+}tDATALOG_SEGMENT;
+
+/** @brief Runtime change of the divider of a channel */
+typedef struct
+{
+    uint8_t     ui8LogNum;              /*!< Log number of the channel.*/
+    uint16_t    ui16OldDivider;         /*!< Divider before the change.*/
+    uint16_t    ui16Divider;            /*!< Divider after the change, 0: channel stopped.*/
+    uint32_t    ui32SampleIdx;          /*!< First sample taken with the new divider (sample count if stopped).*/
+    uint32_t    ui32Tick;               /*!< Service tick of this sample.*/
+}tDATALOG_RATE_MARKER;
+
+/** @brief Segment descriptors of one capture buffer */
+typedef struct
+{
+    uint16_t                ui16Count;
+    tDATALOG_SEGMENT        sSegments[DATALOGGER_MAX_SEGMENTS];
+    uint16_t                ui16MarkerCount;
+    tDATALOG_RATE_MARKER    sMarkers[DATALOGGER_MAX_MARKERS];
+    uint16_t                ui16Divider[MAX_NUM_LOGS];  /*!< Dividers at the start of the capture.*/
+    uint8_t                 ui8CrcChannels;     /*!< Channels with block CRCs.*/
+    uint32_t                ui32BlockCrc[DATALOGGER_CRC_MAX_BLOCKS];
+}tDATALOG_SEGMENT_TABLE;
+
+/** @brief Sequence mode control structure */
+typedef struct
+{
+    uint16_t                ui16SegmentCount;   /*!< Segments per start (1: single capture).*/
+    tDATALOG_SEQMODE        eRearmMode;         /*!< Rearm behaviour of the segments.*/
+    uint16_t                ui16CurSegment;     /*!< Currently recorded segment.*/
+    uint8_t                 ui8Armed;           /*!< Next segment waits for its trigger.*/
+    volatile uint8_t        ui8TriggerPending;  /*!< Trigger has been set.*/
+    tDATALOG_SEGMENT_TABLE  sTables[DATALOGGER_CAPTURE_BUFFERS];
+}tDATALOG_SEQUENCE;
+
+#define tDATALOG_SEQUENCE_DEFAULTS {1, eSEQMODE_IMMEDIATE, 0, 0, 0, {{0, {{0, 0}}, 0, {{0, 0, 0, 0, 0}}, {0}, 0, {0}}}}
+
+/************************************************************************************
+ * Gather mode
+ ***********************************************************************************/
+/** @brief Gather descriptor: Copy of one sample */
+typedef struct
+{
+    const uint8_t   *pui8Src;           /*!< Address of the variable.*/
+    uint8_t         *pui8Dst;           /*!< Target address in the capture buffer.*/
+    uint8_t         ui8Width;           /*!< Byte count.*/
+}tDATALOG_GATHER_DESC;
+
+/** @brief Executes the gather list of one service tick (e.g. by a DMA transfer).
+ *  The transfer has to be completed before the next service tick. */
+typedef void (*tDATALOG_GATHER_CB)(const tDATALOG_GATHER_DESC *psDesc, uint8_t ui8Count, void *pvCtx);
+
+/** @brief Gather mode control structure */
+typedef struct
+{
+    tDATALOG_GATHER_CB      pfnGather;              /*!< Gather hook (NULL: CPU copies the samples).*/
+    void                    *pvCtx;                 /*!< Context of the hook.*/
+    uint8_t                 ui8Channels;            /*!< Channels captured by the hook.*/
+    tDATALOG_GATHER_DESC    sTable[MAX_NUM_LOGS];   /*!< Descriptors of all channels (built by DataloggerInitLogger).*/
+    tDATALOG_GATHER_DESC    sDue[MAX_NUM_LOGS];     /*!< Gather list of the current tick.*/
+}tDATALOG_GATHER;
+
+#define tDATALOG_GATHER_DEFAULTS {NULL, NULL, 0, {{NULL, NULL, 0}}, {{NULL, NULL, 0}}}
 // #define tDATALOG_CONTROL_DEFAULTS {0}
 
+/************************************************************************************
+ * Timebases
+ ***********************************************************************************/
+/** @brief Timebase control structure. Timebase 0 is serviced by DataloggerService,
+ *  the others by DataloggerServiceTimebase. */
+typedef struct
+{
+    uint8_t     ui8Channels[DATALOGGER_MAX_TIMEBASES];  /*!< Channels sampled by each timebase.*/
+    uint16_t    ui16Ratio[DATALOGGER_MAX_TIMEBASES];    /*!< Base ticks per tick of the timebase (0: not configured).*/
+}tDATALOG_TIMEBASES;
+
+#define tDATALOG_TIMEBASES_DEFAULTS {{0xFF}, {1}}
+
 /************************************************************************************
  * Record memory mode header module
  ***********************************************************************************/
@@ -150,9 +442,11 @@ typedef struct
     uint32_t ui32MemoryOffset;  /*!< Offset address of the channel*/
     uint8_t *pui8Variable;      /*!< Memory address of the target variable.*/
     uint8_t  ui8ByteCount;      /*!< Byte count of the variable.*/
+    tDATALOG_SCALING sScaling;  /*!< Data type and scaling of the variable.*/
+    uint32_t ui32BitMask;       /*!< Captured bits of bit channels (0: byte aligned channel).*/
 }tDATALOG_CHANNEL_MEMORY;
 
-#define tDATALOG_CHANNEL_MEMORY_DEFAULTS {0, 0, 0, NULL, 0}
+#define tDATALOG_CHANNEL_MEMORY_DEFAULTS {0, 0, 0, NULL, 0, tDATALOG_SCALING_DEFAULTS, 0}
 // #define tDATALOG_CHANNEL_MEMORY_DEFAULTS {0}
 
 /** @brief Header for the data on an external storage medium */
@@ -204,15 +498,6 @@ typedef struct
 #define tDATALOG_LIVEMODE_TIMER_DEFAULTS {-1, -1}
 // #define tDATALOG_LIVEMODE_TIMER_DEFAULTS {0}
 
-/* typedef struct */
-/* { */
-/*     uint32_t ui32MemoryOffset; */
-/*     uint32_t ui32LastAddress; */
-
-/* }tDATALOG_MEMORY_READ; */
-
-/* #define tsDATALOG_MEMORY_READ_DEFAULTS {0, 0} */
-
 // Main data struct of the datalogger
 typedef struct
 {
@@ -229,6 +514,9 @@ typedef struct
     tDATALOG_MEMORY_HEADER          sMemoryHeader;
     tDATALOG_RECMODEMEM_SERIALIZER  sDatalogSerializer;
     tDATALOG_CONTROL                sDatalogControl;
+    tDATALOG_SEQUENCE               sSequence;
+    tDATALOG_GATHER                 sGather;
+    tDATALOG_TIMEBASES              sTimebases;
     tDATALOGGER_CALLBACKS           sCallbacks;
 }tDATALOGGER;
 
@@ -241,6 +529,9 @@ typedef struct
     tDATALOG_MEMORY_HEADER_DEFAULTS, \
     tDATALOG_RECMODEMEM_SERIALIIZER_DEFAULTS,\
     tDATALOG_CONTROL_DEFAULTS,\
+    tDATALOG_SEQUENCE_DEFAULTS,\
+    tDATALOG_GATHER_DEFAULTS,\
+    tDATALOG_TIMEBASES_DEFAULTS,\
     tDATALOGGER_CALLBACKS_DEFAULTS}
 // #define tDATALOGGER_DEFAULTS {0}
 
@@ -287,7 +578,11 @@ tDATALOG_OPMODES DataloggerGetCurrentOpMode(tDATALOGGER *psDatalog);
 tDATALOG_ERROR DataloggerSetOpMode(tDATALOGGER *psDatalog, tDATALOG_OPMODES eNewOpMode);
 
 /********************************************************************************//**
- * \brief Returns the current operation mode of the datalogger
+ * \brief Returns the data of the last completed capture.
+ * 
+ * With A/B buffering (DATALOGGER_CAPTURE_BUFFERS = 2) the data stays valid while
+ * the next run records into the other buffer. It gets overwritten by the second
+ * DataloggerStart after the capture has been completed.
  * 
  * @param pui8Data  Data pointer to be set to the top of the data memory.
  * @param ui32Len   Pointer to the variable that shall hold the length of the log 
@@ -303,6 +598,110 @@ tDATALOG_ERROR DataloggerGetDataPtr(tDATALOGGER *psDatalog, uint8_t** pui8Data,
  ***********************************************************************************/
 tDATALOG_ERROR DataloggerGetChannelInfo(tDATALOGGER *psDatalog, tDATALOG_CHANNEL *pChannel, uint8_t ui8ChNum);
 
+/********************************************************************************//**
+ * \brief Returns the kind of a channel, e.g. of a DataloggerGetChannelInfo copy.
+ ***********************************************************************************/
+tDATALOG_CHANNEL_KIND DataloggerGetChannelKind(const tDATALOG_CHANNEL *pChannel);
+
+/********************************************************************************//**
+ * \brief Locks the buffer of the last completed capture.
+ * 
+ * A locked buffer is not recorded into by an A/B follow-up run, DataloggerStart 
+ * returns eDATALOG_ERROR_BUFFER_LOCKED instead. Reinitialization is refused as 
+ * well until the lock has been released.
+ * 
+ * @param pui8BufIdx  Pointer to the variable that receives the locked buffer index.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerLockReadout(tDATALOGGER *psDatalog, uint8_t *pui8BufIdx);
+
+/********************************************************************************//**
+ * \brief Releases a buffer locked by DataloggerLockReadout.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerUnlockReadout(tDATALOGGER *psDatalog, uint8_t ui8BufIdx);
+
+/********************************************************************************//**
+ * \brief Returns a zero-copy view on the samples of one channel of the last 
+ * completed capture.
+ * 
+ * The view points directly into the capture buffer and stays valid as long as 
+ * the data returned by DataloggerGetDataPtr.
+ * 
+ * @param pView     Pointer to the view to be filled.
+ * @param ui8ChNum  Channel number to request.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerGetChannelView(tDATALOGGER *psDatalog, tDATALOG_CHANNEL_VIEW *pView, uint8_t ui8ChNum);
+
+/********************************************************************************//**
+ * \brief Returns a view on the samples a running RAM capture has completed so far.
+ * 
+ * Lock free, may be called from another context or core while the service is 
+ * recording. The view covers the committed prefix of the channel (all segments
+ * so far, the current pass of a ring capture). Linear captures don't write these
+ * samples again before the next start. Ring captures overwrite them with the 
+ * next pass once the channel wraps, so a view of a ring capture has to be 
+ * requested again (and consumed before the wrap). Channels of gather mode are 
+ * transferred asynchronously and are only available after the run.
+ * 
+ * @param pView     Pointer to the view to be filled.
+ * @param ui8ChNum  Channel number to request.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerGetCommittedView(tDATALOGGER *psDatalog, tDATALOG_CHANNEL_VIEW *pView, uint8_t ui8ChNum);
+
+/********************************************************************************//**
+ * \brief Returns a block CRC of a channel of the last completed capture.
+ * 
+ * The data of a channel view (DataloggerViewGetLength bytes) is split into 
+ * blocks of DATALOGGER_CRC_BLOCK_SIZE bytes, the last block may be shorter. The
+ * CRC-32 (DataloggerCrc.h) of every block is computed while the block is 
+ * recorded. Available for RAM captures except for ring, gather and histogram 
+ * channels (eDATALOG_ERROR_NOT_IMPLEMENTED).
+ * 
+ * @param ui8ChNum  Channel number to request.
+ * @param ui16Block Block index.
+ * @param pui32Crc  Receives the CRC.
+ * 
+ * @returns Error indicator (eDATALOG_ERROR_NO_DATA behind the last block)
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerGetBlockCrc(tDATALOGGER *psDatalog, uint8_t ui8ChNum, uint16_t ui16Block, uint32_t *pui32Crc);
+
+/********************************************************************************//**
+ * \brief Checks the last completed capture against its block CRCs.
+ * 
+ * @param pui8BadChannels   Receives the channels with corrupted blocks (bit 0: 
+ *                          log number 1), may be NULL.
+ * 
+ * @returns Error indicator (eDATALOG_ERROR_CRC if a block is corrupted)
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerCheckCapture(tDATALOGGER *psDatalog, uint8_t *pui8BadChannels);
+
+/********************************************************************************//**
+ * \brief Returns the bytes of a channel view (whole 32 bit words for bit streams).
+ ***********************************************************************************/
+uint32_t DataloggerViewGetLength(const tDATALOG_CHANNEL_VIEW *pView);
+
+/********************************************************************************//**
+ * \brief Decodes one sample of a channel view into its raw unsigned value.
+ * 
+ * @param pView     Channel view.
+ * @param ui32Idx   Sample index 0 - (pView->ui32Count - 1).
+ ***********************************************************************************/
+uint64_t DataloggerViewGetSample(const tDATALOG_CHANNEL_VIEW *pView, uint32_t ui32Idx);
+
+/********************************************************************************//**
+ * \brief Unpacks a range of samples of a channel view into 32 bit values.
+ *
+ * Bit packed views are read a 32 bit word at a time, byte aligned views are 
+ * read sample by sample. Samples wider than 32 bits are truncated.
+ * 
+ * @param pView         Channel view.
+ * @param pui32Dst      Target array, must hold ui32Count values.
+ * @param ui32Start     First sample to unpack.
+ * @param ui32Count     Number of samples to unpack.
+ *
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerViewUnpack(const tDATALOG_CHANNEL_VIEW *pView, uint32_t *pui32Dst, uint32_t ui32Start, uint32_t ui32Count);
+
 /********************************************************************************//**
  * \brief Returns the datalogger version structure
  ***********************************************************************************/
@@ -318,22 +717,336 @@ tDATALOGGER_VERSION DataloggerGetVersion(tDATALOGGER *psDatalog);
  *                          the time base frequency.
  * @param   ui32RecLen      Length (items, not bytes) of the datalog.
  * @param   pui8Variable    Pointer to the variable to log.
- * @param   ui8ByteCount    Byte count of the variable.
+ * @param   ui8ByteCount    Byte count of the variable (1 - 8).
  * 
  * @returns Error indicator
  ***********************************************************************************/
 tDATALOG_ERROR DataloggerRegisterLog (tDATALOGGER *psDatalog, uint32_t ui32ChID, uint8_t ui8LogNum, uint16_t ui16FreqDiv, uint32_t ui32RecLen, uint8_t *pui8Variable, uint8_t ui8ByteCount);
 tDATALOG_ERROR DataloggerRemoveLog (tDATALOGGER *psDatalog, uint8_t ui8LogNum);
+
+/********************************************************************************//**
+ * \brief Registers a bit channel.
+ *
+ * The bits of ui32BitMask are extracted from the variable and stored densely 
+ * packed, popcount(ui32BitMask) bits per sample. A single flag takes one bit per
+ * sample, a group of flags of one status register takes one bit per flag.
+ *
+ * @param   ui32BitMask     Bits of the variable to capture (bit 0 = LSB).
+ * 
+ * Other parameters: Refer to DataloggerRegisterLog.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerRegisterBitLog (tDATALOGGER *psDatalog, uint32_t ui32ChID, uint8_t ui8LogNum, uint16_t ui16FreqDiv, uint32_t ui32RecLen, uint8_t *pui8Variable, uint8_t ui8ByteCount, uint32_t ui32BitMask);
+
+/********************************************************************************//**
+ * \brief Registers a channel of reduced bit width.
+ *
+ * Only the lower ui8BitWidth bits of the variable are stored, densely packed 
+ * (e.g. 12 bit ADC results take 12 bits instead of 16 bits per sample). Signed 
+ * channels (eDATALOG_TYPE_INT) are sign extended from ui8BitWidth on readout.
+ *
+ * @param   ui8BitWidth     Bits per sample, 1 - (8 * ui8ByteCount).
+ * 
+ * Other parameters: Refer to DataloggerRegisterLog.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerRegisterPackedLog (tDATALOGGER *psDatalog, uint32_t ui32ChID, uint8_t ui8LogNum, uint16_t ui16FreqDiv, uint32_t ui32RecLen, uint8_t *pui8Variable, uint8_t ui8ByteCount, uint8_t ui8BitWidth);
+
+/********************************************************************************//**
+ * \brief Registers a channel whose value is delivered by a getter.
+ *
+ * For computed values, peripheral registers with read sequences or values 
+ * behind accessors. All due channels with the same getter and context are 
+ * served by one getter call per service tick, so channels sharing a divider 
+ * are fetched in one batch.
+ *
+ * @param   pfnGetter       Getter of the value.
+ * @param   pvCtx           Context passed to the getter.
+ * @param   ui8ByteCount    Byte count of the raw value (1 - 8).
+ * 
+ * Other parameters: Refer to DataloggerRegisterLog.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerRegisterGetterLog (tDATALOGGER *psDatalog, uint32_t ui32ChID, uint8_t ui8LogNum, uint16_t ui16FreqDiv, uint32_t ui32RecLen, tDATALOG_GETTER pfnGetter, void *pvCtx, uint8_t ui8ByteCount);
+
+/********************************************************************************//**
+ * \brief Registers a histogram channel.
+ *
+ * Instead of the samples, the channel counts how often the value of the variable
+ * fell into each bin. Bin k covers i32Min + k * 2^ui8BinShift up to the next bin,
+ * values below or above the range are counted in the first or last bin. The bins
+ * are read out like the samples of a normal channel: ui32Bins 32 bit counters 
+ * (big endian, saturating), cleared with every start. The channel keeps counting
+ * until the datalogger is stopped, so the run ends with DataloggerStop if all 
+ * other channels are complete. Only available in eOPMODE_RECMODERAM without 
+ * sequence segments.
+ *
+ * @param   ui32Bins        Number of bins.
+ * @param   ui8ByteCount    Byte count of the variable (1 - 4).
+ * @param   bSigned         Variable is a signed integer.
+ * @param   i32Min          Lower bound of the first bin.
+ * @param   ui8BinShift     Bin width 2^ui8BinShift (0 - 31).
+ * 
+ * Other parameters: Refer to DataloggerRegisterLog.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerRegisterHistogramLog (tDATALOGGER *psDatalog, uint32_t ui32ChID, uint8_t ui8LogNum, uint16_t ui16FreqDiv, uint32_t ui32Bins, 
+                                               uint8_t *pui8Variable, uint8_t ui8ByteCount, bool bSigned, int32_t i32Min, uint8_t ui8BinShift);
+
+/********************************************************************************//**
+ * \brief Sets data type and scaling of a registered log.
+ *
+ * DataloggerRegisterLog resets the scaling to tDATALOG_SCALING_DEFAULTS, so this
+ * function must be called after the registration.
+ *
+ * @param   ui8LogNum       Log number 1 - LOG_NUM_MAX
+ * @param   sScaling        Data type, gain and offset of the variable.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerSetChannelScaling (tDATALOGGER *psDatalog, uint8_t ui8LogNum, tDATALOG_SCALING sScaling);
+
+/********************************************************************************//**
+ * \brief Returns data type and scaling of a log.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerGetChannelScaling (tDATALOGGER *psDatalog, tDATALOG_SCALING *pScaling, uint8_t ui8LogNum);
+
+/********************************************************************************//**
+ * \brief Marks the variable of a registered log as guarded.
+ *
+ * Writers of the variable have to enclose every write with 
+ * DATALOGGER_GUARD_WRITE_BEGIN/END on pui32Seq. The service only takes samples 
+ * with an unchanged, even sequence count. If the variable is being written 
+ * throughout DATALOGGER_GUARD_RETRIES attempts (e.g. the writer has been 
+ * interrupted by the service), the last consistent sample is repeated.
+ * DataloggerRegisterLog removes the guard. Only DataloggerService honours the 
+ * guard, DataloggerStaticService and the C++ wrapper refuse guarded channels.
+ *
+ * @param   ui8LogNum       Log number 1 - LOG_NUM_MAX
+ * @param   pui32Seq        Sequence counter of the variable, NULL removes the guard.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerSetChannelGuard (tDATALOGGER *psDatalog, uint8_t ui8LogNum, const volatile uint32_t *pui32Seq);
+
+/********************************************************************************//**
+ * \brief Sets the anti-alias decimation filter of a registered log.
+ *
+ * The variable is read on every service tick of the channel and passed through
+ * a CIC decimator (ui8Order cascaded moving sums over divider ticks), the stored
+ * sample is the filter output at the divider rate. The filter is computed in 
+ * 64 bit fixed point (integer channels, eDATALOG_TYPE_INT sign extends) with a
+ * gain of divider^ui8Order, which has to stay below 2^(63 - 8 * byte count). The
+ * first ui8Order samples of a run are taken unfiltered while the filter settles,
+ * the following samples lag by ui8Order * (divider - 1) / 2 ticks. Plain RAM and
+ * memory mode channels without guard only. DataloggerRegisterLog removes the filter.
+ *
+ * @param   ui8LogNum       Log number 1 - LOG_NUM_MAX
+ * @param   ui8Order        Filter order 1 - DATALOGGER_CIC_MAX_ORDER, 0: plain divider.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerSetChannelDecimation (tDATALOGGER *psDatalog, uint8_t ui8LogNum, uint8_t ui8Order);
+
+/********************************************************************************//**
+ * \brief Sets the gather hook (RAM mode).
+ *
+ * DataloggerInitLogger builds a descriptor table of the byte aligned channels.
+ * Each service tick hands the descriptors of the due channels to pfnGather 
+ * instead of copying the samples. The samples are stored in target byte order
+ * (eDATALOG_ENCODING_NATIVE). Bit packed and guarded channels are still copied
+ * by the CPU. The datalogger has to be initialized afterwards.
+ *
+ * @param   pfnGather       Gather hook, NULL switches back to CPU copies.
+ * @param   pvCtx           Context passed to the hook.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerSetGather (tDATALOGGER *psDatalog, tDATALOG_GATHER_CB pfnGather, void *pvCtx);
+
+/********************************************************************************//**
+ * \brief Portable gather hook, copies the descriptors with memcpy.
+ ***********************************************************************************/
+void DataloggerGatherMemcpy (const tDATALOG_GATHER_DESC *psDesc, uint8_t ui8Count, void *pvCtx);
+
+/********************************************************************************//**
+ * \brief Configures an additional timebase.
+ *
+ * Timebase ui8Timebase (1 - DATALOGGER_MAX_TIMEBASES - 1) is serviced by 
+ * DataloggerServiceTimebase, e.g. from a slow control loop. It ticks once every 
+ * ui16Ratio ticks of DataloggerService (timebase 0), which keeps the tick of 
+ * the capture and therefore has to run as long as the datalogger is running.
+ *
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerSetTimebase (tDATALOGGER *psDatalog, uint8_t ui8Timebase, uint16_t ui16Ratio);
+
+/********************************************************************************//**
+ * \brief Assigns a registered log to a timebase.
+ *
+ * The divider of the log counts ticks of its timebase. Channels of other 
+ * timebases add no cost to a service call. Logs are registered on timebase 0, 
+ * the gather hook only applies to timebase 0. The datalogger has to be 
+ * initialized afterwards.
+ *
+ * @param   ui8LogNum       Log number 1 - LOG_NUM_MAX
+ * @param   ui8Timebase     Configured timebase.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerSetChannelTimebase (tDATALOGGER *psDatalog, uint8_t ui8LogNum, uint8_t ui8Timebase);
+
+/********************************************************************************//**
+ * \brief Configures the sequence mode.
+ *
+ * One DataloggerStart records ui16Segments segments. The record length of every 
+ * channel is split into equal slices, segment n of a channel starts at 
+ * ui32MemoryOffset + n * (ui32RecordLength / ui16Segments) samples.
+ *
+ * eSEQMODE_RING records one segment as a ring buffer until the datalogger is
+ * stopped (e.g. by a fault). The published capture holds the last record length
+ * samples of every channel, oldest first. Bit channels and runtime divider 
+ * changes are not supported in ring mode.
+ *
+ * @param   ui16Segments    Number of segments per start (1: sequence mode off, ring mode: 1).
+ * @param   eRearmMode      eSEQMODE_IMMEDIATE, eSEQMODE_TRIGGERED or eSEQMODE_RING.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerSetSequence (tDATALOGGER *psDatalog, uint16_t ui16Segments, tDATALOG_SEQMODE eRearmMode);
+
+/********************************************************************************//**
+ * \brief Triggers the next armed segment. May be called from an interrupt.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerTrigger (tDATALOGGER *psDatalog);
+
+/********************************************************************************//**
+ * \brief Changes the divider of a running channel.
+ *
+ * The new divider takes effect at the next service tick of the channel. The next
+ * sample is taken after at most ui16Divider ticks, its index and tick are 
+ * recorded as a rate marker of the capture. Record length and memory layout 
+ * stay unchanged. May be called from another context than the service. A CIC
+ * filter of the channel restarts with the new divider, its warm-up samples are
+ * raw again. The change only holds for the current run, the next start 
+ * restores the registered divider.
+ *
+ * @param   ui8LogNum       Log number 1 - LOG_NUM_MAX
+ * @param   ui16Divider     New frequency divider (> 0).
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerSetChannelDivider (tDATALOGGER *psDatalog, uint8_t ui8LogNum, uint16_t ui16Divider);
+
+/********************************************************************************//**
+ * \brief Stops a running channel for the rest of the run.
+ *
+ * The channel keeps the samples recorded so far, the stop is recorded as a rate 
+ * marker with divider 0. The run ends as soon as all other channels are done.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerStopChannel (tDATALOGGER *psDatalog, uint8_t ui8LogNum);
+
+/********************************************************************************//**
+ * \brief Returns a rate marker of the last completed capture.
+ *
+ * @param   pMarker         Pointer to the data target.
+ * @param   ui16MarkerNum   Marker number 0 - (number of markers - 1), in order of the ticks.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerGetRateMarker (tDATALOGGER *psDatalog, tDATALOG_RATE_MARKER *pMarker, uint16_t ui16MarkerNum);
+
+/********************************************************************************//**
+ * \brief Returns the divider a channel of the last completed capture started with.
+ *
+ * Later changes are described by the rate markers of the capture.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerGetCaptureDivider (tDATALOGGER *psDatalog, uint8_t ui8ChNum, uint16_t *pui16Divider);
+
+/********************************************************************************//**
+ * \brief Returns the descriptor of a recorded segment of the last completed capture.
+ *
+ * @param   pSegment        Pointer to the data target.
+ * @param   ui16SegNum      Segment number 0 - (number of recorded segments - 1).
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerGetSegmentInfo (tDATALOGGER *psDatalog, tDATALOG_SEGMENT *pSegment, uint16_t ui16SegNum);
+
+/********************************************************************************//**
+ * \brief Returns the service tick at which a sample of the last completed capture
+ * has been taken (ticks count from DataloggerStart).
+ *
+ * Ticks are base ticks (timebase 0). Samples of other timebases are placed at
+ * their nominal tick, i.e. ignoring the phase of the timebase.
+ *
+ * @param   ui8ChNum        Channel number 1 - MAX_NUM_LOGS.
+ * @param   ui32Idx         Sample index.
+ * @param   pui32Tick       Pointer to the data target.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerGetSampleTick (tDATALOGGER *psDatalog, uint8_t ui8ChNum, uint32_t ui32Idx, uint32_t *pui32Tick);
+
 tDATALOG_ERROR DataloggerInitLogger (tDATALOGGER *psDatalog, bool bFreeMemory);
+
+/********************************************************************************//**
+ * \brief Reports the memory budget of the currently registered channels.
+ *
+ * @param   pBudget         Pointer to the data target.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerGetBudget (tDATALOGGER *psDatalog, tDATALOG_BUDGET *pBudget);
+
+/********************************************************************************//**
+ * \brief Calculates record lengths which fill the capture memory.
+ *
+ * eSIZING_EQUAL_TIME: The record lengths are chosen inversely proportional to 
+ * the dividers, so every channel covers the same time span.
+ * eSIZING_WEIGHTED: Every channel gets the share pui8Weights[ch] / sum(weights)
+ * of the memory (NULL: equal shares).
+ * Memory left over by rounding is handed out to the channels in ascending order.
+ * The channel configuration is not changed.
+ *
+ * @param   eMode           Sizing mode.
+ * @param   pui8Weights     Weights of the channels (MAX_NUM_LOGS entries), eSIZING_WEIGHTED only.
+ * @param   pui32RecLen     Planned record lengths (MAX_NUM_LOGS entries, 0 for inactive channels).
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerPlanRecordLengths (tDATALOGGER *psDatalog, tDATALOG_SIZING eMode, const uint8_t *pui8Weights, uint32_t *pui32RecLen);
+
+/********************************************************************************//**
+ * \brief Applies the record lengths planned by DataloggerPlanRecordLengths.
+ *
+ * The datalogger has to be initialized afterwards.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerAutoSize (tDATALOGGER *psDatalog, tDATALOG_SIZING eMode, const uint8_t *pui8Weights);
 tDATALOG_ERROR DataloggerStart (tDATALOGGER *psDatalog);
 tDATALOG_STATE DataloggerStop (tDATALOGGER *psDatalog);
 // Datalog service methods
 void DataloggerService (tDATALOGGER *psDatalog);
+
+/********************************************************************************//**
+ * \brief Samples the channels of a timebase, timebase 0 equals DataloggerService.
+ *
+ * Services of different timebases may preempt each other. Segments end with the
+ * next call of DataloggerService.
+ ***********************************************************************************/
+void DataloggerServiceTimebase (tDATALOGGER *psDatalog, uint8_t ui8Timebase);
+
+/********************************************************************************//**
+ * \brief Loads recorded data (channel view layout) of a channel for replay.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerReplayLoad (tDATALOGGER *psDatalog, uint8_t ui8LogNum, const uint8_t *pui8Data, uint32_t ui32Len);
+
+/********************************************************************************//**
+ * \brief Runs up to ui32Ticks replay ticks at once, idle ticks are skipped.
+ *
+ * @param   pui32Done   Number of ticks actually run (optional).
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerReplayAdvance (tDATALOGGER *psDatalog, uint32_t ui32Ticks, uint32_t *pui32Done);
 void DataloggerStatemachine (tDATALOGGER *psDatalog);
 // Internal functions
 void DataloggerSetState (tDATALOGGER *psDatalog);
 void DataloggerSetStateImmediate (tDATALOGGER *psDatalog, tDATALOG_STATE eNewState);
 void _DataloggerClearMemory(tDATALOGGER *psDatalog);
+bool _DataloggerServiceBegin (tDATALOGGER *psDatalog);
+void _DataloggerServiceEnd (tDATALOGGER *psDatalog);
+void _DataloggerCrcAppend (tDATALOG_SEGMENT_TABLE *pTable, tDATALOG_CHANNEL *pChannel, const uint8_t *pui8Data, uint32_t ui32Len);
 
 
 /* extern bool LiveModeDatalogStart (uint8_t ui8Var_count, uint16_t* pui16Var_nr, uint16_t pui16Divider); */
@@ -341,7 +1054,10 @@ void _DataloggerClearMemory(tDATALOGGER *psDatalog);
 /* void LiveModeSampleData (void); */
 /* extern void LiveModeTimerInit (void); */
 // void LiveModeCallback (void);
-/* extern bool InitializeMemoryRead (void); */
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif // DATALOGGER_H_
 // EOF datalog.h-------------------------------------------------------------------
@@ -0,0 +1,398 @@
+/********************************************************************************//**
+ * \file Datalogger.hpp
+ * \author Roman Holderried
+ *
+ * \brief Header-only C++ layer over the datalogger.
+ *
+ * Channel<T> derives byte count and data type of a channel from the variable
+ * type, so variables don't have to be casted to uint8_t* anymore. The sampling
+ * path Logger::Service(channels...) is specialized on the channel widths at
+ * compile time and works on the same tDATALOGGER state as DataloggerService, so
+ * the C readout API keeps working. Requires C++17.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *
+ ***********************************************************************************/
+#ifndef DATALOGGER_HPP_
+#define DATALOGGER_HPP_
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "Datalogger.h"
+
+namespace Datalogger
+{
+/************************************************************************************
+ * Type traits
+ ***********************************************************************************/
+/** @brief Unsigned integer type of a given byte count */
+template <std::size_t N> struct RawType;
+template <> struct RawType<1> { using type = uint8_t; };
+template <> struct RawType<2> { using type = uint16_t; };
+template <> struct RawType<4> { using type = uint32_t; };
+template <> struct RawType<8> { using type = uint64_t; };
+
+/** @brief Compile time properties of a logged variable type */
+template <typename T>
+struct ChannelTraits
+{
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                  "Only arithmetic and enum types can be logged");
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+                  "Unsupported variable width");
+
+    using Raw = typename RawType<sizeof(T)>::type;
+
+    static constexpr uint8_t ui8ByteCount = sizeof(T);
+    static constexpr tDATALOG_DATATYPE eType =
+        std::is_floating_point<T>::value ? eDATALOG_TYPE_FLOAT :
+        std::is_signed<T>::value ? eDATALOG_TYPE_INT : eDATALOG_TYPE_UINT;
+
+    /** Stores a value in big endian format, independent of the target byte order */
+    static inline void StoreBigEndian(uint8_t *pui8Dst, T value) noexcept
+    {
+        Raw raw;
+        std::memcpy(&raw, &value, sizeof(T));
+
+        for (std::size_t j = 0; j < sizeof(T); j++)
+            pui8Dst[j] = static_cast<uint8_t>(static_cast<uint64_t>(raw) >> (8 * (sizeof(T) - 1 - j)));
+    }
+
+    /** Loads a big endian value */
+    static inline T LoadBigEndian(const uint8_t *pui8Src) noexcept
+    {
+        uint64_t ui64Raw = 0;
+        T value;
+
+        for (std::size_t j = 0; j < sizeof(T); j++)
+            ui64Raw = (ui64Raw << 8) | pui8Src[j];
+
+        Raw raw = static_cast<Raw>(ui64Raw);
+        std::memcpy(&value, &raw, sizeof(T));
+        return value;
+    }
+};
+
+/************************************************************************************
+ * Channel
+ ***********************************************************************************/
+/** @brief Typed datalog channel */
+template <typename T>
+class Channel
+{
+public:
+    using Traits = ChannelTraits<T>;
+
+    constexpr Channel(uint8_t ui8LogNum, uint32_t ui32ChID, uint16_t ui16Divider, uint32_t ui32RecLen,
+                      const volatile T &rVariable, float fGain = 1.0f, float fOffset = 0.0f) noexcept
+        : m_ui8LogNum(ui8LogNum), m_ui32ChID(ui32ChID), m_ui16Divider(ui16Divider),
+          m_ui32RecLen(ui32RecLen), m_pVariable(&rVariable), m_fGain(fGain), m_fOffset(fOffset) {}
+
+    constexpr uint8_t LogNum() const noexcept { return m_ui8LogNum; }
+
+    /** Registers the channel including its data type and scaling */
+    tDATALOG_ERROR Register(tDATALOGGER &sDatalog) const noexcept
+    {
+        tDATALOG_ERROR eError = DataloggerRegisterLog(&sDatalog, m_ui32ChID, m_ui8LogNum, m_ui16Divider, m_ui32RecLen,
+                                                      reinterpret_cast<uint8_t*>(const_cast<T*>(m_pVariable)),
+                                                      Traits::ui8ByteCount);
+
+        if (eError != eDATALOG_ERROR_NONE)
+            return eError;
+
+        return DataloggerSetChannelScaling(&sDatalog, m_ui8LogNum, tDATALOG_SCALING{Traits::eType, m_fGain, m_fOffset});
+    }
+
+    /** Samples the variable, same semantics as the channel loop of DataloggerService */
+    inline void Sample(tDATALOGGER &sDatalog) const noexcept
+    {
+        tDATALOG_CHANNEL &rCh = sDatalog.sDatalogControl.sDatalogChannels[m_ui8LogNum - 1];
+        const uint8_t ui8Mask = static_cast<uint8_t>(1u << (m_ui8LogNum - 1));
+
+        if (!(sDatalog.sDatalogControl.ui8ChannelsRunning & ui8Mask) || --rCh.ui16DivideCount)
+            return;
+
+        // Gather mode channels are stored in target byte order
+        if (sDatalog.sGather.ui8Channels & ui8Mask)
+        {
+            T value = *m_pVariable;
+            std::memcpy(&sDatalog.sDatalogControl.pui8Data[rCh.ui32CurMemPos], &value, sizeof(T));
+        }
+        else
+        {
+            uint8_t *pui8Dst = &sDatalog.sDatalogControl.pui8Data[rCh.ui32CurMemPos];
+
+            Traits::StoreBigEndian(pui8Dst, *m_pVariable);
+
+#if DATALOGGER_CRC_BLOCK_SIZE
+            tDATALOG_SEGMENT_TABLE &rTable = sDatalog.sSequence.sTables[sDatalog.sDatalogControl.ui8CaptureBufIdx];
+
+            if (rTable.ui8CrcChannels & ui8Mask)
+                _DataloggerCrcAppend(&rTable, &rCh, pui8Dst, Traits::ui8ByteCount);
+#endif
+
+            // Publish the sample for DataloggerGetCommittedView
+            DATALOGGER_ATOMIC_STORE32(&rCh.ui32CommittedCount, rCh.ui32CurrentCount + 1);
+        }
+
+        rCh.ui32CurMemPos += Traits::ui8ByteCount;
+
+        if (++rCh.ui32CurrentCount == rCh.ui32SegmentEnd)
+            sDatalog.sDatalogControl.ui8ChannelsRunning &= static_cast<uint8_t>(~ui8Mask);
+
+        rCh.ui16DivideCount = rCh.ui16Divider;
+    }
+
+private:
+    uint8_t             m_ui8LogNum;
+    uint32_t            m_ui32ChID;
+    uint16_t            m_ui16Divider;
+    uint32_t            m_ui32RecLen;
+    const volatile T   *m_pVariable;
+    float               m_fGain;
+    float               m_fOffset;
+};
+
+/************************************************************************************
+ * Capture
+ ***********************************************************************************/
+/** @brief Move-only handle on a completed capture.
+ *
+ * The capture buffer stays locked for the lifetime of the handle, so A/B
+ * follow-up runs cannot overwrite it. */
+class Capture
+{
+public:
+    Capture() noexcept = default;
+
+    explicit Capture(tDATALOGGER &sDatalog) noexcept
+    {
+        uint32_t ui32Len;
+
+        if (DataloggerLockReadout(&sDatalog, &m_ui8BufIdx) != eDATALOG_ERROR_NONE)
+            return;
+
+        m_psDatalog = &sDatalog;
+
+        if (DataloggerGetDataPtr(m_psDatalog, &m_pui8Data, &ui32Len) != eDATALOG_ERROR_NONE)
+        {
+            Release();
+            return;
+        }
+
+        m_ui32Len = ui32Len;
+
+        for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
+        {
+            if (DataloggerGetChannelView(m_psDatalog, &m_sViews[i], i + 1) != eDATALOG_ERROR_NONE)
+                m_sViews[i] = tDATALOG_CHANNEL_VIEW tDATALOG_CHANNEL_VIEW_DEFAULTS;
+        }
+    }
+
+    ~Capture() { Release(); }
+
+    Capture(const Capture&) = delete;
+    Capture& operator=(const Capture&) = delete;
+
+    Capture(Capture &&rOther) noexcept { MoveFrom(rOther); }
+
+    Capture& operator=(Capture &&rOther) noexcept
+    {
+        if (this != &rOther)
+        {
+            Release();
+            MoveFrom(rOther);
+        }
+        return *this;
+    }
+
+    bool Valid() const noexcept { return m_psDatalog != nullptr; }
+    const uint8_t* Data() const noexcept { return m_pui8Data; }
+    uint32_t Length() const noexcept { return m_ui32Len; }
+
+    /** Zero-copy view on a channel (log number 1 - MAX_NUM_LOGS), empty view for other numbers */
+    const tDATALOG_CHANNEL_VIEW& View(uint8_t ui8LogNum) const noexcept
+    {
+        static const tDATALOG_CHANNEL_VIEW sEmpty = tDATALOG_CHANNEL_VIEW_DEFAULTS;
+
+        if (ui8LogNum == 0 || ui8LogNum > MAX_NUM_LOGS)
+            return sEmpty;
+
+        return m_sViews[ui8LogNum - 1];
+    }
+
+    /** Number of recorded samples of a channel */
+    template <typename T>
+    uint32_t Count(const Channel<T> &rChannel) const noexcept { return View(rChannel.LogNum()).ui32Count; }
+
+    /** Typed access to sample ui32Idx of a channel */
+    template <typename T>
+    T At(const Channel<T> &rChannel, uint32_t ui32Idx) const noexcept
+    {
+        const tDATALOG_CHANNEL_VIEW &rView = View(rChannel.LogNum());
+        T value;
+
+        // Gather mode stores the samples in target byte order
+        if (rView.eEncoding == eDATALOG_ENCODING_NATIVE)
+        {
+            std::memcpy(&value, DATALOGGER_VIEW_SAMPLE_PTR(&rView, ui32Idx), sizeof(T));
+            return value;
+        }
+
+        return ChannelTraits<T>::LoadBigEndian(DATALOGGER_VIEW_SAMPLE_PTR(&rView, ui32Idx));
+    }
+
+private:
+    void Release() noexcept
+    {
+        if (m_psDatalog != nullptr)
+            DataloggerUnlockReadout(m_psDatalog, m_ui8BufIdx);
+
+        m_psDatalog = nullptr;
+        m_pui8Data = nullptr;
+        m_ui32Len = 0;
+    }
+
+    void MoveFrom(Capture &rOther) noexcept
+    {
+        m_psDatalog = rOther.m_psDatalog;
+        m_ui8BufIdx = rOther.m_ui8BufIdx;
+        m_pui8Data = rOther.m_pui8Data;
+        m_ui32Len = rOther.m_ui32Len;
+        std::memcpy(m_sViews, rOther.m_sViews, sizeof(m_sViews));
+        rOther.m_psDatalog = nullptr;
+        rOther.m_pui8Data = nullptr;
+        rOther.m_ui32Len = 0;
+    }
+
+    tDATALOGGER            *m_psDatalog = nullptr;
+    uint8_t                 m_ui8BufIdx = 0;
+    uint8_t                *m_pui8Data = nullptr;
+    uint32_t                m_ui32Len = 0;
+    tDATALOG_CHANNEL_VIEW   m_sViews[MAX_NUM_LOGS] = {};
+};
+
+/************************************************************************************
+ * Logger
+ ***********************************************************************************/
+/** @brief Owner of a datalogger instance and its capture buffers.
+ *
+ * Service(channels...) stores plain RECMODERAM samples only, Register and Init
+ * refuse other operating modes and channel types (bit, getter, histogram, 
+ * guarded, decimated, secondary timebase). */
+class Logger
+{
+public:
+    explicit Logger(tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS) noexcept
+    {
+        DataloggerInit(&m_sDatalog, sCallbacks);
+    }
+
+    ~Logger()
+    {
+        // A Capture must not outlive its Logger
+        assert(m_sDatalog.sDatalogControl.ui8ReadoutLocks == 0);
+
+        if (m_sDatalog.eDatalogState == eDLOGSTATE_RUNNING)
+            DataloggerStop(&m_sDatalog);
+
+        // Locked buffers are leaked rather than freed under a reader
+        if (!m_sDatalog.sDatalogControl.ui8ReadoutLocks)
+            DataloggerClearMemory(&m_sDatalog);
+    }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+    Logger(Logger&&) = delete;
+    Logger& operator=(Logger&&) = delete;
+
+    /** Registers all given channels */
+    template <typename... Ts>
+    tDATALOG_ERROR Register(const Channel<Ts>&... rChannels) noexcept
+    {
+        tDATALOG_ERROR eError = eDATALOG_ERROR_NONE;
+
+        ((eError = (eError == eDATALOG_ERROR_NONE) ? rChannels.Register(m_sDatalog) : eError), ...);
+
+        // Channels registered through Native() may be of other types
+        if (eError == eDATALOG_ERROR_NONE)
+            eError = CheckChannels();
+
+        return eError;
+    }
+
+    tDATALOG_ERROR Init() noexcept
+    {
+        tDATALOG_ERROR eError = CheckChannels();
+
+        if (eError != eDATALOG_ERROR_NONE)
+            return eError;
+
+        return DataloggerInitLogger(&m_sDatalog, true);
+    }
+    tDATALOG_ERROR Start() noexcept { return DataloggerStart(&m_sDatalog); }
+    void Stop() noexcept { DataloggerStop(&m_sDatalog); }
+    tDATALOG_ERROR Trigger() noexcept { return DataloggerTrigger(&m_sDatalog); }
+    void Statemachine() noexcept { DataloggerStatemachine(&m_sDatalog); }
+    tDATALOG_STATE State() const noexcept { return m_sDatalog.eDatalogState; }
+
+    /** Samples the given channels. Must be called with all channels of the run. */
+    template <typename... Ts>
+    inline void Service(const Channel<Ts>&... rChannels) noexcept
+    {
+        if (!_DataloggerServiceBegin(&m_sDatalog))
+            return;
+
+        (rChannels.Sample(m_sDatalog), ...);
+
+        _DataloggerServiceEnd(&m_sDatalog);
+    }
+
+    /** Generic sampling path of the C module */
+    void Service() noexcept { DataloggerService(&m_sDatalog); }
+
+    /** Handle on the last completed capture, check Capture::Valid() */
+    Capture GetCapture() noexcept { return Capture(m_sDatalog); }
+
+    /** Access to the C instance, e.g. for the SCI interface */
+    tDATALOGGER& Native() noexcept { return m_sDatalog; }
+
+private:
+    /** Refuses configurations Channel::Sample cannot record */
+    tDATALOG_ERROR CheckChannels() const noexcept
+    {
+        const tDATALOG_CONTROL &rControl = m_sDatalog.sDatalogControl;
+
+        if (rControl.eOpMode != eOPMODE_RECMODERAM)
+            return eDATALOG_ERROR_WRONG_OPMODE;
+
+        for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
+        {
+            const tDATALOG_CHANNEL &rCh = rControl.sDatalogChannels[i];
+
+            if (!(rControl.ui8ActiveLoggers & (1u << i)))
+                continue;
+
+            if (rCh.ui8BitWidth || rCh.pfnGetter != nullptr || rCh.ui8HistByteCount || rCh.pui32Guard != nullptr || 
+                rCh.ui8CicOrder || !(m_sDatalog.sTimebases.ui8Channels[0] & (1u << i)))
+                return eDATALOG_ERROR_NOT_IMPLEMENTED;
+        }
+
+        return eDATALOG_ERROR_NONE;
+    }
+
+    tDATALOGGER m_sDatalog = tDATALOGGER_DEFAULTS;
+};
+
+} // namespace Datalogger
+
+#endif // DATALOGGER_HPP_
+// EOF
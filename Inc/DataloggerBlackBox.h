@@ -0,0 +1,165 @@
+/********************************************************************************//**
+ * \file DataloggerBlackBox.h
+ * \author Roman Holderried
+ *
+ * \brief Flight recorder: Always-on ring capture, frozen on a fault and persisted
+ * to non-volatile storage outside the interrupt context.
+ *
+ * Storage layout at the base address:
+ *  - Commit block (16 bytes, little endian): "DLBB", image length (u32), 
+ *    CRC-32 of the image (u32), freeze reason (u32).
+ *  - Image: Capture in the export stream format (see DataloggerExport.h).
+ *
+ * The commit block is erased first and written last, an interrupted persist
+ * leaves no valid image behind.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+#ifndef DATALOGGERBLACKBOX_H_
+#define DATALOGGERBLACKBOX_H_
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+#include "DataloggerExport.h"
+#include "DataloggerStorage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************************************************************************
+ * Defines
+ ***********************************************************************************/
+#define DATALOGGER_BLACKBOX_COMMIT_SIZE 16
+
+/************************************************************************************
+ * Enum Type definitions
+ ***********************************************************************************/
+typedef enum
+{
+    eBLACKBOX_IDLE      = 0,    /*!< Recording or stopped, nothing to persist */
+    eBLACKBOX_ERASE     = 1,    /*!< Erasing the storage region */
+    eBLACKBOX_WRITE     = 2,    /*!< Writing the image */
+    eBLACKBOX_COMMIT    = 3,    /*!< Writing the commit block */
+    eBLACKBOX_DONE      = 4     /*!< Image persisted */
+}tDATALOG_BLACKBOX_STATE;
+
+/************************************************************************************
+ * Structure type definitions
+ ***********************************************************************************/
+/** @brief Black box instance */
+typedef struct
+{
+    tDATALOGGER                 *psDatalog;     /*!< Recording datalogger.*/
+    const tDATALOG_STORAGE      *pStorage;      /*!< Storage backend.*/
+    uint32_t                    ui32Base;       /*!< Base address of the storage region.*/
+    uint32_t                    ui32Size;       /*!< Size of the storage region.*/
+    volatile tDATALOG_BLACKBOX_STATE eState;    /*!< Persist state.*/
+    volatile uint8_t            ui8Frozen;      /*!< Set by the freeze.*/
+    uint32_t                    ui32Reason;     /*!< Freeze reason.*/
+    // Persist state
+    uint8_t                     ui8BufIdx;      /*!< Locked readout buffer.*/
+    uint8_t                     ui8PartCount;   /*!< Header plus channel regions.*/
+    uint8_t                     ui8Part;        /*!< Part being written.*/
+    uint32_t                    ui32PartPos;    /*!< Written bytes of the part.*/
+    uint32_t                    ui32Addr;       /*!< Next storage address.*/
+    uint32_t                    ui32Checksum;   /*!< Checksum of the written bytes.*/
+    const uint8_t               *pui8Part[1 + MAX_NUM_LOGS];
+    uint32_t                    ui32PartLen[1 + MAX_NUM_LOGS];
+    uint8_t                     ui8Header[DATALOGGER_EXPORT_HEADER_MAX_SIZE];
+    uint8_t                     ui8Commit[DATALOGGER_BLACKBOX_COMMIT_SIZE];
+}tDATALOG_BLACKBOX;
+
+/** @brief Persisted image found by DataloggerBlackBoxRecover */
+typedef struct
+{
+    uint32_t    ui32Length;                     /*!< Image length in bytes.*/
+    uint32_t    ui32Reason;                     /*!< Reason passed to the freeze.*/
+}tDATALOG_BLACKBOX_IMAGE;
+
+/************************************************************************************
+ * Function declarations
+ ***********************************************************************************/
+/********************************************************************************//**
+ * \brief Sets up a black box on a datalogger with registered channels.
+ * 
+ * @param pBB           Black box instance.
+ * @param psDatalog     Datalogger (RAM op mode), channels registered.
+ * @param pStorage      Storage backend, must stay valid while in use.
+ * @param ui32Base      Base address of the storage region.
+ * @param ui32Size      Size of the storage region (commit block and image).
+ *
+ * On flash the region should start and end at sector boundaries.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerBlackBoxInit (tDATALOG_BLACKBOX *pBB, tDATALOGGER *psDatalog, const tDATALOG_STORAGE *pStorage, 
+                                       uint32_t ui32Base, uint32_t ui32Size);
+
+/********************************************************************************//**
+ * \brief Starts (or restarts after a persist) the ring recording.
+ *
+ * The datalogger is switched to eSEQMODE_RING and initialized if required.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerBlackBoxStart (tDATALOG_BLACKBOX *pBB);
+
+/********************************************************************************//**
+ * \brief Freezes the recording, e.g. from a fault handler.
+ *
+ * Constant time and interrupt safe, the capture is not copied. The last record 
+ * length samples of every channel are persisted by DataloggerBlackBoxService.
+ * 
+ * @param pBB           Black box instance.
+ * @param ui32Reason    Application defined fault code, stored with the image.
+ * 
+ * @returns Error indicator (eDATALOG_ERROR_WRONG_STATE if not recording)
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerBlackBoxFreeze (tDATALOG_BLACKBOX *pBB, uint32_t ui32Reason);
+
+/********************************************************************************//**
+ * \brief Persists a frozen capture, to be called from the main loop.
+ *
+ * Requires DataloggerStatemachine to be called as usual, so the frozen capture 
+ * is published. Writes one chunk of DATALOGGER_BLACKBOX_CHUNK bytes per call and
+ * returns while the backend is busy. The capture stays locked until the commit
+ * block is written (pBB->eState == eBLACKBOX_DONE).
+ * 
+ * @returns Error indicator (the persist is abandoned on errors)
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerBlackBoxService (tDATALOG_BLACKBOX *pBB);
+
+/********************************************************************************//**
+ * \brief Looks for a persisted image, e.g. on the next boot.
+ *
+ * Checks the commit block and the checksum of the image.
+ * 
+ * @param pBB           Black box instance.
+ * @param pImage        Found image.
+ * 
+ * @returns Error indicator (eDATALOG_ERROR_NO_DATA if no valid image is stored)
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerBlackBoxRecover (tDATALOG_BLACKBOX *pBB, tDATALOG_BLACKBOX_IMAGE *pImage);
+
+/********************************************************************************//**
+ * \brief Reads ui32Len bytes of the persisted image from ui32Offset on.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerBlackBoxRead (tDATALOG_BLACKBOX *pBB, uint32_t ui32Offset, uint8_t *pui8Data, uint32_t ui32Len);
+
+/********************************************************************************//**
+ * \brief Invalidates the persisted image (erases the commit block).
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerBlackBoxClear (tDATALOG_BLACKBOX *pBB);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DATALOGGERBLACKBOX_H_
+// EOF
@@ -0,0 +1,58 @@
+/********************************************************************************//**
+ * \file DataloggerConvert.h
+ * \author Roman Holderried
+ *
+ * \brief Bulk conversion of captured channels into engineering units.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+#ifndef DATALOGGERCONVERT_H_
+#define DATALOGGERCONVERT_H_
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include "Datalogger.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************************************************************************
+ * Function declarations
+ ***********************************************************************************/
+/********************************************************************************//**
+ * \brief Converts a range of samples of a channel view into scaled float values.
+ * 
+ * @param pView         Channel view (see DataloggerGetChannelView).
+ * @param pScaling      Data type and scaling of the channel.
+ * @param pfDst         Target array, must hold ui32Count values.
+ * @param ui32Start     First sample to convert.
+ * @param ui32Count     Number of samples to convert.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerConvertToFloat(const tDATALOG_CHANNEL_VIEW *pView, const tDATALOG_SCALING *pScaling, float *pfDst, uint32_t ui32Start, uint32_t ui32Count);
+
+/********************************************************************************//**
+ * \brief Converts a range of samples of a channel view into scaled double values.
+ * 
+ * @param pView         Channel view (see DataloggerGetChannelView).
+ * @param pScaling      Data type and scaling of the channel.
+ * @param pdDst         Target array, must hold ui32Count values.
+ * @param ui32Start     First sample to convert.
+ * @param ui32Count     Number of samples to convert.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerConvertToDouble(const tDATALOG_CHANNEL_VIEW *pView, const tDATALOG_SCALING *pScaling, double *pdDst, uint32_t ui32Start, uint32_t ui32Count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DATALOGGERCONVERT_H_
+// EOF
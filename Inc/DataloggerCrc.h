@@ -0,0 +1,63 @@
+/********************************************************************************//**
+ * \file DataloggerCrc.h
+ * \author Roman Holderried
+ *
+ * \brief CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320).
+ *
+ * Slice-by-8 with 8 KB of tables on host builds, a 64 byte nibble table on
+ * targets. Select with DATALOGGER_CRC_SLICE_BY_8 (DataloggerCfg.h).
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+#ifndef DATALOGGERCRC_H_
+#define DATALOGGERCRC_H_
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include "DataloggerCfg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************************************************************************
+ * Defines
+ ***********************************************************************************/
+#ifndef DATALOGGER_CRC_SLICE_BY_8
+#if defined(__unix__) || defined(__APPLE__) || defined(_WIN32)
+#define DATALOGGER_CRC_SLICE_BY_8   1
+#else
+#define DATALOGGER_CRC_SLICE_BY_8   0
+#endif
+#endif
+
+/** CRC of no data, start value of DataloggerCrc32Update */
+#define DATALOGGER_CRC32_INIT       0
+
+/************************************************************************************
+ * Function declarations
+ ***********************************************************************************/
+/********************************************************************************//**
+ * \brief Continues a CRC-32 over further data.
+ *
+ * DataloggerCrc32Update(DataloggerCrc32Update(DATALOGGER_CRC32_INIT, a, n), b, m) 
+ * is the CRC of a and b in sequence, e.g. the CRC of "123456789" is 0xCBF43926.
+ * 
+ * @param ui32Crc   CRC of the preceding data (DATALOGGER_CRC32_INIT at the start).
+ * @param pui8Data  Data.
+ * @param ui32Len   Byte count.
+ * 
+ * @returns CRC including the data.
+ ***********************************************************************************/
+uint32_t DataloggerCrc32Update (uint32_t ui32Crc, const uint8_t *pui8Data, uint32_t ui32Len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DATALOGGERCRC_H_
+// EOF
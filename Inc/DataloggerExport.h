@@ -0,0 +1,125 @@
+/********************************************************************************//**
+ * \file DataloggerExport.h
+ * \author Roman Holderried
+ *
+ * \brief Streaming export of captures to a file descriptor (host builds only),
+ * portable builder of the stream header.
+ *
+ * Stream format (all header fields little endian):
+ *  - File header (16 bytes): "DLOG", version major, version minor, channel count,
+ *    flags (bit 0: CRC trailer follows), segment count (u16), marker count (u16),
+ *    header size incl. descriptors and markers (u32).
+ *  - One channel descriptor (32 bytes) per channel: channel ID (u32), log number,
+ *    encoding (tDATALOG_ENCODING), byte width, bit width, divider at the start 
+ *    of the capture (u16), data type, channel kind (tDATALOG_CHANNEL_KIND), 
+ *    sample count (u32), data length (u32), gain (f32), offset (f32), tick of 
+ *    the first sample (u32).
+ *  - One rate marker (16 bytes) per runtime divider change: log number, 0, old
+ *    divider (u16), new divider (u16, 0: channel stopped), 0 (u16), sample 
+ *    index (u32), tick (u32).
+ *  - Channel data in descriptor order, unchanged from the capture buffer.
+ *  - Optional CRC trailer: "DLCR", block size (u32), then per channel in 
+ *    descriptor order the block count (u32) and the CRC-32 of each block (u32).
+ *
+ * Block records (DataloggerExportBlock): "DLBK", log number, 0, 0, 0, 
+ * first sample (u32), data length (u32), followed by the data.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+#ifndef DATALOGGEREXPORT_H_
+#define DATALOGGEREXPORT_H_
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************************************************************************
+ * Defines
+ ***********************************************************************************/
+#define DATALOGGER_EXPORT_FILE_HEADER_SIZE      16
+#define DATALOGGER_EXPORT_CHANNEL_HEADER_SIZE   32
+#define DATALOGGER_EXPORT_BLOCK_HEADER_SIZE     16
+#define DATALOGGER_EXPORT_MARKER_SIZE           16
+/** Header size with all channels active and all markers in use */
+#define DATALOGGER_EXPORT_HEADER_MAX_SIZE       (DATALOGGER_EXPORT_FILE_HEADER_SIZE + MAX_NUM_LOGS * DATALOGGER_EXPORT_CHANNEL_HEADER_SIZE + \
+                                                 DATALOGGER_MAX_MARKERS * DATALOGGER_EXPORT_MARKER_SIZE)
+/** Trailer size with all block CRCs in use */
+#define DATALOGGER_EXPORT_TRAILER_MAX_SIZE      (8 + MAX_NUM_LOGS * 4 + DATALOGGER_CRC_MAX_BLOCKS * 4)
+
+#define DATALOGGER_EXPORT_FLAG_CRC              0x01
+
+/************************************************************************************
+ * Function declarations
+ ***********************************************************************************/
+/********************************************************************************//**
+ * \brief Builds the stream header of the last completed capture.
+ *
+ * Available on all targets, e.g. to persist captures in the stream format. The
+ * capture should be locked by the caller. The channel data follows the header 
+ * in the order of the log numbers, DataloggerViewGetLength bytes from the 
+ * base of each channel view.
+ * 
+ * @param psDatalog     Datalogger instance.
+ * @param pui8Header    Target, DATALOGGER_EXPORT_HEADER_MAX_SIZE bytes.
+ * 
+ * @returns Header size in bytes, 0 if no capture is available.
+ ***********************************************************************************/
+uint32_t DataloggerExportHeader (tDATALOGGER *psDatalog, uint8_t *pui8Header);
+
+/********************************************************************************//**
+ * \brief Builds the CRC trailer of the last completed capture.
+ * 
+ * @param psDatalog     Datalogger instance.
+ * @param pui8Trailer   Target, DATALOGGER_EXPORT_TRAILER_MAX_SIZE bytes. NULL
+ *                      only returns the size.
+ * 
+ * @returns Trailer size in bytes, 0 if the capture carries no block CRCs.
+ ***********************************************************************************/
+uint32_t DataloggerExportTrailer (tDATALOGGER *psDatalog, uint8_t *pui8Trailer);
+
+#if defined(__unix__) || defined(__APPLE__)
+/********************************************************************************//**
+ * \brief Writes the last completed capture to a file descriptor.
+ *
+ * The header and the channel regions of the capture buffer are written with
+ * one writev call (repeated on partial writes), the samples are not copied.
+ * The capture is locked during the export.
+ * 
+ * @param psDatalog     Datalogger instance.
+ * @param iFd           File descriptor (file, pipe, socket).
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerExportCapture (tDATALOGGER *psDatalog, int iFd);
+
+/********************************************************************************//**
+ * \brief Writes a block of channel data as soon as it is complete.
+ *
+ * For modes which hand out the data block wise instead of a finished capture.
+ * 
+ * @param iFd               File descriptor.
+ * @param ui8LogNum         Log number of the channel.
+ * @param ui32FirstSample   Index of the first sample of the block.
+ * @param pui8Data          Block data.
+ * @param ui32Len           Byte count of the block.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerExportBlock (int iFd, uint8_t ui8LogNum, uint32_t ui32FirstSample, const uint8_t *pui8Data, uint32_t ui32Len);
+
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DATALOGGEREXPORT_H_
+// EOF
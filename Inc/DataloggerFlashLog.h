@@ -0,0 +1,195 @@
+/********************************************************************************//**
+ * \file DataloggerFlashLog.h
+ * \author Roman Holderried
+ *
+ * \brief Append-only capture log for NOR/NAND flash backends.
+ *
+ * The storage region is written page by page in one direction and wraps around.
+ * Pages are numbered by a sequence number, the page position in the region is
+ * the sequence number modulo the page count. An erase block is erased right
+ * before its first page is programmed, so all erase blocks wear evenly and no
+ * page is programmed twice between two erases.
+ *
+ * Page layout (DATALOGGER_FLASHLOG_PAGE_SIZE bytes, little endian):
+ *  - Header (20 bytes): "DLPG", sequence number (u32), sequence number of the
+ *    first page of the capture (u32), payload length (u16), flags, 0, CRC-32
+ *    of the header bytes 0 - 15 and the payload (u32).
+ *  - Payload, padded with 0xFF. All pages of a capture but the last one are
+ *    full, the last one carries DATALOGGER_FLASHLOG_FLAG_END.
+ *
+ * Mounting reads the first page of every erase block and the pages of the newest
+ * block, the latest capture is found from its end page.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *
+ ***********************************************************************************/
+#ifndef DATALOGGERFLASHLOG_H_
+#define DATALOGGERFLASHLOG_H_
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+#include "DataloggerStorage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************************************************************************
+ * Defines
+ ***********************************************************************************/
+#define DATALOGGER_FLASHLOG_HEADER_SIZE     20
+#define DATALOGGER_FLASHLOG_PAYLOAD_SIZE    (DATALOGGER_FLASHLOG_PAGE_SIZE - DATALOGGER_FLASHLOG_HEADER_SIZE)
+#define DATALOGGER_FLASHLOG_FLAG_END        0x01
+
+#if DATALOGGER_FLASHLOG_PAGE_SIZE <= DATALOGGER_FLASHLOG_HEADER_SIZE
+#error DATALOGGER_FLASHLOG_PAGE_SIZE must exceed the page header
+#endif
+
+/************************************************************************************
+ * Structure type definitions
+ ***********************************************************************************/
+/** @brief Capture stored in the log */
+typedef struct
+{
+    uint32_t    ui32FirstSeq;                   /*!< Sequence number of the first page.*/
+    uint32_t    ui32Length;                     /*!< Capture length in bytes.*/
+}tDATALOG_FLASHLOG_CAPTURE;
+
+/** @brief Flash log instance */
+typedef struct
+{
+    const tDATALOG_STORAGE      *pStorage;      /*!< Storage backend.*/
+    uint32_t                    ui32Base;       /*!< Base address of the region.*/
+    uint32_t                    ui32BlockSize;  /*!< Erase block size.*/
+    uint32_t                    ui32PagesPerBlock;
+    uint32_t                    ui32PageCount;  /*!< Pages of the region.*/
+    uint32_t                    ui32Seq;        /*!< Sequence number of the next page.*/
+    uint8_t                     ui8Mounted;     /*!< Set by DataloggerFlashLogMount.*/
+    uint8_t                     ui8Erased;      /*!< Erase block of the next page has been erased.*/
+    // Latest complete capture
+    uint8_t                     ui8LatestValid;
+    tDATALOG_FLASHLOG_CAPTURE   sLatest;
+    // Capture being written
+    uint8_t                     ui8Open;        /*!< Capture open for writing.*/
+    uint32_t                    ui32CaptureSeq; /*!< First page of the open capture.*/
+    uint32_t                    ui32CaptureLen; /*!< Bytes written to the open capture.*/
+    uint32_t                    ui32CapturePages;
+    // Page buffers: One is filled while the other one is programmed
+    uint8_t                     ui8FillIdx;     /*!< Buffer being filled.*/
+    uint8_t                     ui8ProgIdx;     /*!< Buffer of the next (or pending) program.*/
+    uint8_t                     ui8Queued;      /*!< Buffers waiting for the program (bit mask).*/
+    uint8_t                     ui8EndPage;     /*!< Buffers holding the end page (bit mask).*/
+    uint8_t                     ui8Programming; /*!< A page program is pending.*/
+    uint16_t                    ui16FillLen[2];
+    uint8_t                     ui8Page[2][DATALOGGER_FLASHLOG_PAGE_SIZE];
+    // Storage view of a capture (DataloggerFlashLogStorage)
+    tDATALOG_FLASHLOG_CAPTURE   sView;
+}tDATALOG_FLASHLOG;
+
+/************************************************************************************
+ * Function declarations
+ ***********************************************************************************/
+/********************************************************************************//**
+ * \brief Sets up a flash log on a storage region.
+ *
+ * @param pLog          Flash log instance.
+ * @param pStorage      Storage backend, must stay valid while in use.
+ * @param ui32Base      Base address of the region (erase block aligned).
+ * @param ui32Size      Size of the region, at least two erase blocks.
+ * @param ui32BlockSize Erase block size, multiple of DATALOGGER_FLASHLOG_PAGE_SIZE.
+ *
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerFlashLogInit (tDATALOG_FLASHLOG *pLog, const tDATALOG_STORAGE *pStorage,
+                                       uint32_t ui32Base, uint32_t ui32Size, uint32_t ui32BlockSize);
+
+/********************************************************************************//**
+ * \brief Finds the write position and the latest complete capture, e.g. on boot.
+ *
+ * Reads one page per erase block plus the pages of the newest erase block.
+ * Interrupted captures and torn pages are skipped.
+ *
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerFlashLogMount (tDATALOG_FLASHLOG *pLog);
+
+/********************************************************************************//**
+ * \brief Returns the latest complete capture.
+ *
+ * @returns Error indicator (eDATALOG_ERROR_NO_DATA if none is stored)
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerFlashLogLatest (tDATALOG_FLASHLOG *pLog, tDATALOG_FLASHLOG_CAPTURE *pCapture);
+
+/********************************************************************************//**
+ * \brief Opens a new capture for writing.
+ *
+ * The previous capture must be completely programmed (DataloggerFlashLogService).
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerFlashLogBegin (tDATALOG_FLASHLOG *pLog);
+
+/********************************************************************************//**
+ * \brief Appends data to the open capture.
+ *
+ * Never waits for the storage. Takes as many bytes as fit into the free page
+ * buffer, full pages are programmed by DataloggerFlashLogService.
+ *
+ * @param pui32Done     Receives the number of bytes taken.
+ *
+ * @returns Error indicator (eDATALOG_ERROR_NOT_ENOUGH_MEMORY if the capture
+ *          would overwrite its own beginning)
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerFlashLogWrite (tDATALOG_FLASHLOG *pLog, const uint8_t *pui8Data, uint32_t ui32Len, uint32_t *pui32Done);
+
+/********************************************************************************//**
+ * \brief Closes the open capture, its end page is programmed by the service.
+ *
+ * @returns Error indicator (eDATALOG_ERROR_BUFFER_LOCKED while both page buffers
+ *          are waiting for the storage, retry later)
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerFlashLogEnd (tDATALOG_FLASHLOG *pLog);
+
+/********************************************************************************//**
+ * \brief Erases blocks and programs pages, to be called from the main loop.
+ *
+ * Returns while the backend is busy. The capture becomes the latest capture
+ * when its end page is programmed.
+ *
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerFlashLogService (tDATALOG_FLASHLOG *pLog);
+
+/********************************************************************************//**
+ * \brief Reads ui32Len bytes of a capture from ui32Offset on.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerFlashLogRead (tDATALOG_FLASHLOG *pLog, const tDATALOG_FLASHLOG_CAPTURE *pCapture,
+                                       uint32_t ui32Offset, uint8_t *pui8Data, uint32_t ui32Len);
+
+/********************************************************************************//**
+ * \brief Checks the header and the CRC of all pages of a capture.
+ *
+ * @returns Error indicator (eDATALOG_ERROR_CRC on a corrupted page)
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerFlashLogCheck (tDATALOG_FLASHLOG *pLog, const tDATALOG_FLASHLOG_CAPTURE *pCapture);
+
+/********************************************************************************//**
+ * \brief Sets up a read-only storage which maps the addresses 0 - length of a
+ * capture to its payload, e.g. for a readout with a storage size of length.
+ *
+ * @param pLog          Flash log instance, one view at a time.
+ * @param pCapture      Capture to map.
+ * @param pView         Storage interface to set up.
+ ***********************************************************************************/
+void DataloggerFlashLogStorage (tDATALOG_FLASHLOG *pLog, const tDATALOG_FLASHLOG_CAPTURE *pCapture, tDATALOG_STORAGE *pView);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DATALOGGERFLASHLOG_H_
+// EOF
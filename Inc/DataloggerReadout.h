@@ -0,0 +1,132 @@
+/********************************************************************************//**
+ * \file DataloggerReadout.h
+ * \author Roman Holderried
+ *
+ * \brief Non-blocking readout of captures from the storage backend to an upstream
+ * (e.g. the SCI data channel).
+ *
+ * Two blocks of DATALOGGER_READOUT_CHUNK bytes are buffered: While block N is
+ * sent, block N + 1 is read from the storage. The readout runs at the speed of
+ * the slower side instead of the sum of both latencies.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *
+ ***********************************************************************************/
+#ifndef DATALOGGERREADOUT_H_
+#define DATALOGGERREADOUT_H_
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+#include "DataloggerStorage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************************************************************************
+ * Enum Type definitions
+ ***********************************************************************************/
+typedef enum
+{
+    eREADOUT_IDLE       = 0,    /*!< No readout started or readout aborted */
+    eREADOUT_RUNNING    = 1,    /*!< Blocks are read and sent */
+    eREADOUT_DONE       = 2     /*!< All bytes have been sent */
+}tDATALOG_READOUT_STATE;
+
+/************************************************************************************
+ * Structure type definitions
+ ***********************************************************************************/
+/** @brief Upstream of the readout.
+ *
+ *  Send may return before the transfer is complete, IsBusy reports the end of
+ *  the transfer. The data passed to Send stays valid until IsBusy returns false. */
+typedef struct
+{
+    tDATALOG_ERROR  (*Send)(const uint8_t *pui8Data, uint32_t ui32Len, void *pvCtx);
+    bool            (*IsBusy)(void *pvCtx);     /*!< Optional, NULL for blocking upstreams.*/
+    void            *pvCtx;                     /*!< Passed to all upstream calls.*/
+}tDATALOG_UPSTREAM;
+
+#define tDATALOG_UPSTREAM_DEFAULTS {NULL, NULL, NULL}
+
+/** @brief Readout instance */
+typedef struct
+{
+    const tDATALOG_STORAGE      *pStorage;      /*!< Storage backend.*/
+    const tDATALOG_UPSTREAM     *pUpstream;     /*!< Receiver of the data.*/
+    uint32_t                    ui32StorageSize; /*!< Readable bytes of the storage.*/
+    volatile tDATALOG_READOUT_STATE eState;     /*!< Readout state.*/
+    uint8_t                     ui8Abort;       /*!< Set by DataloggerReadoutAbort.*/
+    uint32_t                    ui32Addr;       /*!< Next storage address to read.*/
+    uint32_t                    ui32Remaining;  /*!< Bytes not read yet.*/
+    uint32_t                    ui32Sent;       /*!< Bytes passed to the upstream.*/
+    // Double buffer
+    uint8_t                     ui8ReadIdx;     /*!< Buffer of the next (or pending) read.*/
+    uint8_t                     ui8SendIdx;     /*!< Buffer of the next (or pending) send.*/
+    uint8_t                     ui8Reading;     /*!< A read is pending.*/
+    uint8_t                     ui8Sending;     /*!< A send is pending.*/
+    uint8_t                     ui8Full;        /*!< Buffers holding data to send (bit mask).*/
+    uint32_t                    ui32BufLen[2];
+    uint8_t                     ui8Buf[2][DATALOGGER_READOUT_CHUNK];
+}tDATALOG_READOUT;
+
+/************************************************************************************
+ * Function declarations
+ ***********************************************************************************/
+/********************************************************************************//**
+ * \brief Sets up a readout.
+ *
+ * @param pReadout      Readout instance.
+ * @param pStorage      Storage backend, must stay valid while in use. ReadAsync is
+ *                      used if available, Read otherwise.
+ * @param pUpstream     Upstream, must stay valid while in use.
+ * @param ui32StorageSize   Readable bytes of the storage, regions beyond are 
+ *                          refused by DataloggerReadoutStart.
+ *
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerReadoutInit (tDATALOG_READOUT *pReadout, const tDATALOG_STORAGE *pStorage, const tDATALOG_UPSTREAM *pUpstream, 
+                                      uint32_t ui32StorageSize);
+
+/********************************************************************************//**
+ * \brief Starts the transfer of a storage region, e.g. the capture of the
+ * memory op mode (0 to tDATALOG_MEMORY_HEADER.ui32LastAddress).
+ *
+ * The region must not be written by a recording during the readout.
+ *
+ * @returns Error indicator (eDATALOG_ERROR_WRONG_STATE while a readout runs, 
+ *          eDATALOG_ERROR_INVALID_PARAMETER if the region exceeds the storage)
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerReadoutStart (tDATALOG_READOUT *pReadout, uint32_t ui32Addr, uint32_t ui32Len);
+
+/********************************************************************************//**
+ * \brief Advances the readout, to be called from the main loop.
+ *
+ * Never waits for the storage or the upstream. Completed reads are handed to the
+ * upstream as soon as it is free, and the next block is read into the buffer
+ * released by the last completed send.
+ *
+ * @returns Error indicator (the readout is abandoned on errors)
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerReadoutService (tDATALOG_READOUT *pReadout);
+
+/********************************************************************************//**
+ * \brief Stops a running readout.
+ *
+ * Pending transfers are completed by DataloggerReadoutService before the state
+ * changes to eREADOUT_IDLE.
+ ***********************************************************************************/
+void DataloggerReadoutAbort (tDATALOG_READOUT *pReadout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DATALOGGERREADOUT_H_
+// EOF
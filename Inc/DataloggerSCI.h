@@ -26,7 +26,7 @@
 #error "The Datalogger SCI interface only supports VALUE_MODE_HEX at the moment"
 #endif
 
-#define SIZE_OF_RETURN_VAL_BUFFER   5
+#define SIZE_OF_RETURN_VAL_BUFFER   6
 
 /************************************************************************************
  * Function declarations
@@ -87,13 +87,40 @@ COMMAND_CB_STATUS StopDatalogger (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen
  ***********************************************************************************/
 COMMAND_CB_STATUS GetLogData (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PROCESS_INFO *pInfo);
 
+/********************************************************************************//**
+ * \brief Starts the streaming readout of the storage (sDataloggerReadout[Index]).
+ *
+ * Arguments: Index, optional start address and length. Without a region the 
+ * capture of the memory op mode is sent (eDATALOG_ERROR_NO_DATA in other op 
+ * modes). Regions beyond the storage size of the readout instance are refused. The data is passed to the upstream of
+ * the readout instance block by block by DataloggerReadoutService.
+ * 
+ * Callback of type COMMAND_CB (Refer to the SCI command structure definition)
+ ***********************************************************************************/
+COMMAND_CB_STATUS GetMemoryData (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PROCESS_INFO *pInfo);
+
 /********************************************************************************//**
  * \brief Returns the channel data.
  * 
+ * Returns channel ID, divider of the capture, record length, current count, 
+ * memory offset and the channel kind (tDATALOG_CHANNEL_KIND). Histogram channels
+ * hold bin counts instead of samples.
+ * 
  * Callback of type COMMAND_CB (Refer to the SCI command structure definition)
  ***********************************************************************************/
 COMMAND_CB_STATUS GetChannelInfo (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PROCESS_INFO *pInfo);
 
+/********************************************************************************//**
+ * \brief Returns a rate marker of the last completed capture.
+ *
+ * Arguments: Index, marker number (0 - number of markers - 1). Returns log number,
+ * old divider, new divider (0: channel stopped), sample index and tick. 
+ * eDATALOG_ERROR_NO_DATA behind the last marker.
+ * 
+ * Callback of type COMMAND_CB (Refer to the SCI command structure definition)
+ ***********************************************************************************/
+COMMAND_CB_STATUS GetRateMarker (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PROCESS_INFO *pInfo);
+
 /********************************************************************************//**
  * \brief Resets the Datalogger.
  * 
@@ -101,6 +128,22 @@ COMMAND_CB_STATUS GetChannelInfo (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen
  ***********************************************************************************/
 COMMAND_CB_STATUS ResetDatalogger (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PROCESS_INFO *pInfo);
 
+/********************************************************************************//**
+ * \brief Returns capacity, required and remaining capture memory.
+ * 
+ * Callback of type COMMAND_CB (Refer to the SCI command structure definition)
+ ***********************************************************************************/
+COMMAND_CB_STATUS GetMemoryBudget (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PROCESS_INFO *pInfo);
+
+/********************************************************************************//**
+ * \brief Sizes the record lengths to fill the capture memory.
+ *
+ * Arguments: Index, sizing mode (tDATALOG_SIZING), optional weights of channel 1 - 8.
+ * 
+ * Callback of type COMMAND_CB (Refer to the SCI command structure definition)
+ ***********************************************************************************/
+COMMAND_CB_STATUS AutoSizeRecordLengths (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PROCESS_INFO *pInfo);
+
 #endif
 #endif //DATALOGGERSCI_H_
 // EOF
@@ -0,0 +1,119 @@
+/********************************************************************************//**
+ * \file DataloggerShard.h
+ * \author Roman Holderried
+ *
+ * \brief Per-core datalogger shards with a tick ordered merge.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+#ifndef DATALOGGERSHARD_H_
+#define DATALOGGERSHARD_H_
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************************************************************************
+ * Structure type definitions
+ ***********************************************************************************/
+/** @brief One sample of the merged capture */
+typedef struct
+{
+    uint32_t    ui32Tick;               /*!< Service tick of the sample.*/
+    uint8_t     ui8LogNum;              /*!< Log number of the channel.*/
+    uint8_t     ui8Shard;               /*!< Shard that recorded the sample.*/
+    uint64_t    ui64Value;              /*!< Raw sample value.*/
+}tDATALOG_SHARD_SAMPLE;
+
+/** @brief Set of shards sharing one channel configuration */
+typedef struct
+{
+    tDATALOGGER *psShards;                          /*!< Shard instances, one per core.*/
+    uint8_t     ui8ShardCount;                      /*!< Number of shards.*/
+    uint8_t     ui8ChannelShard[MAX_NUM_LOGS];      /*!< Shard recording the channel.*/
+    // Merge state
+    uint8_t     ui8MergeLocks[DATALOGGER_MAX_SHARDS];/*!< Locked readout buffer of each shard.*/
+    uint32_t    ui32MergeIdx[MAX_NUM_LOGS];         /*!< Next sample of each channel.*/
+    uint8_t     ui8Merging;                         /*!< Merge in progress.*/
+}tDATALOG_SHARD_SET;
+
+#define tDATALOG_SHARD_SET_DEFAULTS {NULL, 0, {0}, {0}, {0}, 0}
+
+/************************************************************************************
+ * Function declarations
+ ***********************************************************************************/
+/********************************************************************************//**
+ * \brief Creates the shards from a shared configuration.
+ *
+ * psConfig holds the registered channels of all cores, the operation mode, the
+ * gather hook, the sequence settings and the timebases are taken over as well.
+ * Every shard records only the channels assigned to it and is serviced by its
+ * own core with DataloggerService(&psShards[core]), so the cores never write 
+ * to common data. The shards are reset to their defaults (DataloggerReset, so 
+ * they have to be defined with tDATALOGGER_DEFAULTS or zeroed) and initialized
+ * (DataloggerInitLogger). All fields of pSet are set.
+ * 
+ * @param pSet              Shard set.
+ * @param psShards          Shard instances (ui8ShardCount entries).
+ * @param ui8ShardCount     Number of shards (1 - DATALOGGER_MAX_SHARDS).
+ * @param psConfig          Datalogger holding the shared channel configuration.
+ * @param pui8ChannelShard  Shard of every channel (MAX_NUM_LOGS entries).
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerShardInit (tDATALOG_SHARD_SET *pSet, tDATALOGGER *psShards, uint8_t ui8ShardCount, 
+                                    tDATALOGGER *psConfig, const uint8_t *pui8ChannelShard);
+
+/********************************************************************************//**
+ * \brief Starts all shards.
+ *
+ * The shard ticks are only comparable if all shards are started before the first
+ * service call of the run and are serviced from the same tick source.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerShardStart (tDATALOG_SHARD_SET *pSet);
+
+/********************************************************************************//**
+ * \brief Stops all shards.
+ ***********************************************************************************/
+void DataloggerShardStop (tDATALOG_SHARD_SET *pSet);
+
+/********************************************************************************//**
+ * \brief Locks the last completed capture of every shard for the merge.
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerShardMergeBegin (tDATALOG_SHARD_SET *pSet);
+
+/********************************************************************************//**
+ * \brief Returns the next samples of all shards in ascending tick order.
+ *
+ * Samples of the same tick are ordered by log number. Can be called repeatedly 
+ * until *pui32Count is 0.
+ *
+ * @param pSet              Shard set.
+ * @param pDst              Target array.
+ * @param ui32MaxCount      Size of the target array.
+ * @param pui32Count        Number of samples written.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerShardMerge (tDATALOG_SHARD_SET *pSet, tDATALOG_SHARD_SAMPLE *pDst, uint32_t ui32MaxCount, uint32_t *pui32Count);
+
+/********************************************************************************//**
+ * \brief Releases the captures locked by DataloggerShardMergeBegin.
+ ***********************************************************************************/
+void DataloggerShardMergeEnd (tDATALOG_SHARD_SET *pSet);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DATALOGGERSHARD_H_
+// EOF
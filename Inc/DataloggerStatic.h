@@ -0,0 +1,57 @@
+/********************************************************************************//**
+ * \file DataloggerStatic.h
+ * \author Roman Holderried
+ *
+ * \brief Service routine generated from the static channel configuration.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+#ifndef DATALOGGERSTATIC_H_
+#define DATALOGGERSTATIC_H_
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef DATALOGGER_STATIC_CHANNELS
+/************************************************************************************
+ * Function declarations
+ ***********************************************************************************/
+/********************************************************************************//**
+ * \brief Registers the channels of DATALOGGER_STATIC_CHANNELS and initializes the 
+ * datalogger.
+ *
+ * Only plain channels in eOPMODE_RECMODERAM are supported. Other registered 
+ * channels are refused, options set afterwards (guards, decimation, timebases)
+ * are ignored by DataloggerStaticService.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerStaticInit (tDATALOGGER *psDatalog);
+
+/********************************************************************************//**
+ * \brief Samples the static channels. Replaces DataloggerService.
+ *
+ * Offsets and widths are compile time constants, the routine is fully unrolled
+ * over the configured channels. The configured dividers are registered, runtime
+ * changes (DataloggerSetChannelDivider, DataloggerStopChannel) are followed. The
+ * readout API is the same as for DataloggerService.
+ ***********************************************************************************/
+void DataloggerStaticService (tDATALOGGER *psDatalog);
+
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DATALOGGERSTATIC_H_
+// EOF
@@ -0,0 +1,90 @@
+/********************************************************************************//**
+ * \file DataloggerStorage.h
+ * \author Roman Holderried
+ *
+ * \brief Non-volatile storage interface for persisted captures, file backed 
+ * stand-in for host builds.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+#ifndef DATALOGGERSTORAGE_H_
+#define DATALOGGERSTORAGE_H_
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************************************************************************
+ * Structure type definitions
+ ***********************************************************************************/
+/** @brief Storage backend (e.g. flash or FRAM driver).
+ *
+ *  Write and Erase may return before the transfer is complete, IsBusy reports
+ *  the end of the transfer. Read returns with the data. The data passed to Write stays valid until
+ *  IsBusy returns false. Erased memory reads as 0xFF. 
+ *
+ *  ReadAsync is optional (e.g. DMA reads): It starts a read and returns, the data 
+ *  is complete when IsBusy returns false. Used by the streaming readout. */
+typedef struct
+{
+    tDATALOG_ERROR  (*Write)(uint32_t ui32Addr, const uint8_t *pui8Data, uint32_t ui32Len, void *pvCtx);
+    tDATALOG_ERROR  (*Read)(uint32_t ui32Addr, uint8_t *pui8Data, uint32_t ui32Len, void *pvCtx);
+    tDATALOG_ERROR  (*Erase)(uint32_t ui32Addr, uint32_t ui32Len, void *pvCtx);
+    bool            (*IsBusy)(void *pvCtx);     /*!< Optional, NULL for blocking backends.*/
+    void            *pvCtx;                     /*!< Passed to all backend calls.*/
+    tDATALOG_ERROR  (*ReadAsync)(uint32_t ui32Addr, uint8_t *pui8Data, uint32_t ui32Len, void *pvCtx);  /*!< Optional.*/
+}tDATALOG_STORAGE;
+
+#define tDATALOG_STORAGE_DEFAULTS {NULL, NULL, NULL, NULL, NULL, NULL}
+
+#if defined(__unix__) || defined(__APPLE__)
+/** @brief Context of the file backed storage */
+typedef struct
+{
+    int         iFd;                            /*!< File descriptor of the storage file.*/
+    uint32_t    ui32Size;                       /*!< Storage size in bytes.*/
+}tDATALOG_STORAGE_FILE;
+
+#define tDATALOG_STORAGE_FILE_DEFAULTS {-1, 0}
+
+/************************************************************************************
+ * Function declarations
+ ***********************************************************************************/
+/********************************************************************************//**
+ * \brief Opens (or creates) a file as storage, e.g. to test persistence on Linux.
+ *
+ * The file keeps its content, so it survives a restart of the process like the
+ * flash of the target survives a reset. New files are filled with 0xFF. The 
+ * backend is blocking, IsBusy is not set.
+ * 
+ * @param pStorage      Storage interface to set up.
+ * @param pFile         Context of the backend, must stay valid while in use.
+ * @param pcPath        Path of the storage file.
+ * @param ui32Size      Storage size in bytes.
+ * 
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerStorageFileOpen (tDATALOG_STORAGE *pStorage, tDATALOG_STORAGE_FILE *pFile, const char *pcPath, uint32_t ui32Size);
+
+/********************************************************************************//**
+ * \brief Closes the storage file.
+ ***********************************************************************************/
+void DataloggerStorageFileClose (tDATALOG_STORAGE_FILE *pFile);
+
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DATALOGGERSTORAGE_H_
+// EOF
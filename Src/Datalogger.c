@@ -18,15 +18,50 @@
 #include <string.h>
 #include "DataloggerCfg.h"
 #include "Datalogger.h"
+#include "DataloggerCrc.h"
 
 /************************************************************************************
  * Defines
  ***********************************************************************************/
+// Op modes working on the RAM capture buffers
+#define CAPTURE_BUFFER_MODE(psDatalog)  ((psDatalog)->sDatalogControl.eOpMode == eOPMODE_RECMODERAM || \
+                                         (psDatalog)->sDatalogControl.eOpMode == eOPMODE_REPLAY)
 
 /************************************************************************************
  * Globals
  ***********************************************************************************/
 
+/************************************************************************************
+ * Private function declarations
+ ***********************************************************************************/
+static bool _DataloggerReadoutAvailable (tDATALOGGER *psDatalog);
+static void _DataloggerStartSegment (tDATALOGGER *psDatalog);
+static void _DataloggerSegmentComplete (tDATALOGGER *psDatalog);
+static void _DataloggerPublishCapture (tDATALOGGER *psDatalog);
+static uint32_t _DataloggerChannelByteSize (tDATALOG_CHANNEL *pChannel);
+static uint32_t _DataloggerPlannedByteSize (tDATALOG_CHANNEL *pChannel, uint32_t ui32RecLen);
+static uint32_t _DataloggerMaxRecordLength (tDATALOG_CHANNEL *pChannel, uint32_t ui32Bytes);
+static tDATALOG_ERROR _DataloggerRegisterChannel (tDATALOGGER *psDatalog, uint32_t ui32ChID, uint8_t ui8LogNum, uint16_t ui16FreqDiv, uint32_t ui32RecLen, uint8_t *pui8Variable, uint8_t ui8ByteCount, uint32_t ui32BitMask);
+static void _DataloggerPackSample (uint8_t *pui8Data, tDATALOG_CHANNEL *pChannel);
+static inline uint64_t _DataloggerLoad (const uint8_t *pui8Variable, uint8_t ui8ByteCount);
+static inline uint64_t _DataloggerReadVariable (tDATALOG_CHANNEL *pChannel);
+static void _DataloggerCallGetters (tDATALOGGER *psDatalog, uint8_t ui8Channels);
+static void _DataloggerFlushBits (uint8_t *pui8Data, tDATALOG_CHANNEL *pChannel);
+static uint32_t _DataloggerTickDivider (tDATALOGGER *psDatalog, uint8_t ui8Idx);
+static bool _DataloggerSampleChannels (tDATALOGGER *psDatalog, uint8_t ui8Channels);
+static uint16_t _DataloggerTimebaseRatio (tDATALOGGER *psDatalog, uint8_t ui8Idx);
+static tDATALOG_ERROR _DataloggerRequestRateChange (tDATALOGGER *psDatalog, uint8_t ui8LogNum, uint16_t ui16Divider);
+static void _DataloggerApplyRateChanges (tDATALOGGER *psDatalog, uint8_t ui8Channels);
+static void _DataloggerRingWrap (tDATALOGGER *psDatalog, uint8_t ui8Channels);
+static void _DataloggerRingUnroll (tDATALOGGER *psDatalog);
+static tDATALOG_RATE_MARKER* _DataloggerReserveMarker (tDATALOG_SEGMENT_TABLE *pTable);
+static inline void _DataloggerStore (uint8_t *pui8Variable, uint8_t ui8ByteCount, uint64_t ui64Val);
+static void _DataloggerReplaySample (uint8_t *pui8Data, tDATALOG_CHANNEL *pChannel);
+static void _DataloggerHistogramSample (uint8_t *pui8Data, tDATALOG_CHANNEL *pChannel);
+static inline void _DataloggerDecimate (tDATALOG_CHANNEL *pChannel);
+static bool _DataloggerCicInRange (uint8_t ui8Order, uint16_t ui16Divider, uint8_t ui8ByteCount);
+static void _DataloggerViewFormat (tDATALOGGER *psDatalog, tDATALOG_CHANNEL_VIEW *pView, uint8_t ui8Idx);
+
 /************************************************************************************
  * Function definitions
  ***********************************************************************************/
@@ -52,6 +87,9 @@ tDATALOG_ERROR DataloggerReset(tDATALOGGER *psDatalog)
             break;
     }
 
+    if (psDatalog->sDatalogControl.ui8ReadoutLocks)
+        return eDATALOG_ERROR_BUFFER_LOCKED;
+
     // Free all acquired memory
     _DataloggerClearMemory(psDatalog);
 
@@ -75,10 +113,18 @@ tDATALOGGER* DataloggerGetData(tDATALOGGER *psDatalog,)
 //===================================================================================
 void _DataloggerClearMemory (tDATALOGGER *psDatalog)
 {
-    if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODERAM && psDatalog->sDatalogControl.ui8MemoryAcquired)
+    if (CAPTURE_BUFFER_MODE(psDatalog) && psDatalog->sDatalogControl.ui8MemoryAcquired)
     {
-        free(psDatalog->sDatalogControl.pui8Data);
+        for (uint8_t i = 0; i < DATALOGGER_CAPTURE_BUFFERS; i++)
+        {
+            free(psDatalog->sDatalogControl.pui8CaptureBuf[i]);
+            psDatalog->sDatalogControl.pui8CaptureBuf[i] = NULL;
+        }
+
+        psDatalog->sDatalogControl.pui8Data = NULL;
+        psDatalog->sDatalogControl.pui8ReadoutData = NULL;
         psDatalog->sDatalogControl.ui8MemoryAcquired = 0;
+        psDatalog->sDatalogControl.ui32MemCapacity = 0;
     }
 
     else if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODEMEM)
@@ -144,6 +190,7 @@ tDATALOG_ERROR DataloggerSetOpMode(tDATALOGGER *psDatalog, tDATALOG_OPMODES eNew
             return eDATALOG_ERROR_NOT_IMPLEMENTED;
 
         case eOPMODE_RECMODERAM:
+        case eOPMODE_REPLAY:
             break;
 
         default:
@@ -151,23 +198,43 @@ tDATALOG_ERROR DataloggerSetOpMode(tDATALOGGER *psDatalog, tDATALOG_OPMODES eNew
     }
 
     psDatalog->sDatalogControl.eOpMode = eNewOpMode;
+    psDatalog->sDatalogControl.ui8LayoutDirty = 0xFF;
     DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_UNINITIALIZED);
 
     return eDATALOG_ERROR_NONE;
 }
 
+//===================================================================================
+static bool _DataloggerReadoutAvailable (tDATALOGGER *psDatalog)
+{
+    // While a follow-up run is recording into the other capture buffer, the last 
+    // completed capture can still be read out.
+    switch(psDatalog->eDatalogState)
+    {
+        case eDLOGSTATE_DATA_READY:
+            return true;
+
+        case eDLOGSTATE_RUNNING:
+        case eDLOGSTATE_ABORTING:
+            return psDatalog->sDatalogControl.pui8ReadoutData != NULL;
+
+        default:
+            return false;
+    }
+}
+
 //===================================================================================
 tDATALOG_ERROR DataloggerGetDataPtr(tDATALOGGER *psDatalog, uint8_t** pui8Data, uint32_t *ui32Len)
 {
     // Data must be available
-    if (psDatalog->eDatalogState != eDLOGSTATE_DATA_READY)
+    if (!_DataloggerReadoutAvailable(psDatalog))
         return eDATALOG_ERROR_WRONG_STATE;
 
     // Memory mode datalogger cannot be read out directly
     if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODEMEM)
         return eDATALOG_ERROR_WRONG_OPMODE;
 
-    *pui8Data = psDatalog->sDatalogControl.pui8Data;
+    *pui8Data = psDatalog->sDatalogControl.pui8ReadoutData;
     *ui32Len = psDatalog->sDatalogControl.ui32MemLen;
 
     return eDATALOG_ERROR_NONE;
@@ -188,53 +255,337 @@ tDATALOG_ERROR DataloggerGetChannelInfo(tDATALOGGER *psDatalog, tDATALOG_CHANNEL
 }
 
 //===================================================================================
-tDATALOGGER_VERSION DataloggerGetVersion(tDATALOGGER *psDatalog)
+tDATALOG_CHANNEL_KIND DataloggerGetChannelKind(const tDATALOG_CHANNEL *pChannel)
 {
-    return psDatalog->sVersion;
+    if (pChannel->pfnGetter != NULL)
+        return eDATALOG_CHKIND_GETTER;
+
+    if (pChannel->ui8HistByteCount)
+        return eDATALOG_CHKIND_HISTOGRAM;
+
+    if (pChannel->ui32BitMask)
+        return eDATALOG_CHKIND_BIT;
+
+    return eDATALOG_CHKIND_PLAIN;
 }
 
 //===================================================================================
-tDATALOG_ERROR DataloggerRegisterLog (tDATALOGGER *psDatalog, uint32_t ui32ChID, uint8_t ui8LogNum, uint16_t ui16FreqDiv, uint32_t ui32RecLen, uint8_t *pui8Variable, uint8_t ui8ByteCount)
+tDATALOG_ERROR DataloggerLockReadout(tDATALOGGER *psDatalog, uint8_t *pui8BufIdx)
 {
-    tDATALOG_CHANNEL        *pChannel; 
-    tDATALOG_CHANNEL_MEMORY *pMemChannel;
+    if (!_DataloggerReadoutAvailable(psDatalog))
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    *pui8BufIdx = psDatalog->sDatalogControl.ui8ReadoutBufIdx;
+    psDatalog->sDatalogControl.ui8ReadoutLocks |= (1 << *pui8BufIdx);
+
+    return eDATALOG_ERROR_NONE;
+}
 
-    if (ui8LogNum > MAX_NUM_LOGS)
+//===================================================================================
+tDATALOG_ERROR DataloggerUnlockReadout(tDATALOGGER *psDatalog, uint8_t ui8BufIdx)
+{
+    if (ui8BufIdx >= DATALOGGER_CAPTURE_BUFFERS)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    psDatalog->sDatalogControl.ui8ReadoutLocks &= ~(1 << ui8BufIdx);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerGetChannelView(tDATALOGGER *psDatalog, tDATALOG_CHANNEL_VIEW *pView, uint8_t ui8ChNum)
+{
+    tDATALOG_CHANNEL *pChannel;
+
+    if (ui8ChNum == 0 || ui8ChNum > MAX_NUM_LOGS)
         return eDATALOG_ERROR_NUMBER_OF_LOGS_EXCEEDED;
     
-    pChannel = &psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1];
-    pMemChannel = &psDatalog->sMemoryHeader.sDatalogChannelsMemory[ui8LogNum - 1];
+    if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << (ui8ChNum - 1))))
+        return eDATALOG_ERROR_CHANNEL_NOT_ACTIVE;
 
-    if (!(psDatalog->eDatalogState != eDLOGSTATE_INITIALIZED ||
-        psDatalog->eDatalogState != eDLOGSTATE_UNINITIALIZED))
+    if (!_DataloggerReadoutAvailable(psDatalog))
         return eDATALOG_ERROR_WRONG_STATE;
 
-    // Initialize parameter variables
-    pChannel->ui32ChID = pMemChannel->ui32ChannelID     = ui32ChID;
-    pChannel->pui8Variable = pMemChannel->pui8Variable  = pui8Variable;
-    pChannel->ui8ByteCount = pMemChannel->ui8ByteCount  = ui8ByteCount;
-    pChannel->ui16Divider = pMemChannel->ui16Divider    = ui16FreqDiv;
-    pChannel->ui32RecordLength                          = ui32RecLen;
+    if (!CAPTURE_BUFFER_MODE(psDatalog))
+        return eDATALOG_ERROR_WRONG_OPMODE;
 
-    // Activate logger immediately
-    psDatalog->sDatalogControl.ui8ActiveLoggers |= (1 << (ui8LogNum - 1));
+    pChannel = &psDatalog->sDatalogControl.sDatalogChannels[ui8ChNum - 1];
 
-    // New value is set -> Need to initialize the datalogger prior to next log run.
-    DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_UNINITIALIZED);
+    pView->pui8Base = psDatalog->sDatalogControl.pui8ReadoutData + pChannel->ui32MemoryOffset;
+    pView->ui32Count = psDatalog->sDatalogControl.ui32ReadoutCount[ui8ChNum - 1];
+    _DataloggerViewFormat(psDatalog, pView, ui8ChNum - 1);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerGetCommittedView(tDATALOGGER *psDatalog, tDATALOG_CHANNEL_VIEW *pView, uint8_t ui8ChNum)
+{
+    tDATALOG_CHANNEL *pChannel;
+
+    if (ui8ChNum == 0 || ui8ChNum > MAX_NUM_LOGS)
+        return eDATALOG_ERROR_NUMBER_OF_LOGS_EXCEEDED;
+    
+    if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << (ui8ChNum - 1))))
+        return eDATALOG_ERROR_CHANNEL_NOT_ACTIVE;
+
+    if (psDatalog->eDatalogState != eDLOGSTATE_RUNNING)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    if (psDatalog->sDatalogControl.eOpMode != eOPMODE_RECMODERAM)
+        return eDATALOG_ERROR_WRONG_OPMODE;
+
+    if (psDatalog->sGather.ui8Channels & (1 << (ui8ChNum - 1)))
+        return eDATALOG_ERROR_NOT_IMPLEMENTED;
+
+    pChannel = &psDatalog->sDatalogControl.sDatalogChannels[ui8ChNum - 1];
+
+    // Samples below the committed count are complete
+    pView->ui32Count = DATALOGGER_ATOMIC_LOAD32(&pChannel->ui32CommittedCount);
+    pView->pui8Base = psDatalog->sDatalogControl.pui8Data + pChannel->ui32MemoryOffset;
+    _DataloggerViewFormat(psDatalog, pView, ui8ChNum - 1);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerGetBlockCrc(tDATALOGGER *psDatalog, uint8_t ui8ChNum, uint16_t ui16Block, uint32_t *pui32Crc)
+{
+#if DATALOGGER_CRC_BLOCK_SIZE
+    tDATALOG_SEGMENT_TABLE *pTable = &psDatalog->sSequence.sTables[psDatalog->sDatalogControl.ui8ReadoutBufIdx];
+    tDATALOG_CHANNEL_VIEW sView;
+    tDATALOG_ERROR eError;
+
+    eError = DataloggerGetChannelView(psDatalog, &sView, ui8ChNum);
+
+    if (eError != eDATALOG_ERROR_NONE)
+        return eError;
+
+    if (!(pTable->ui8CrcChannels & (1 << (ui8ChNum - 1))))
+        return eDATALOG_ERROR_NOT_IMPLEMENTED;
+
+    if ((uint32_t)ui16Block * DATALOGGER_CRC_BLOCK_SIZE >= DataloggerViewGetLength(&sView))
+        return eDATALOG_ERROR_NO_DATA;
+
+    *pui32Crc = pTable->ui32BlockCrc[psDatalog->sDatalogControl.sDatalogChannels[ui8ChNum - 1].ui16CrcFirstBlock + ui16Block];
+
+    return eDATALOG_ERROR_NONE;
+#else
+    return eDATALOG_ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerCheckCapture(tDATALOGGER *psDatalog, uint8_t *pui8BadChannels)
+{
+    tDATALOG_CHANNEL_VIEW sView;
+    uint8_t ui8Bad = 0;
+    uint32_t ui32Crc;
+
+    if (!_DataloggerReadoutAvailable(psDatalog))
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    for (uint8_t i = 1; i <= MAX_NUM_LOGS; i++)
+    {
+        uint32_t ui32Bytes;
+
+        if (DataloggerGetBlockCrc(psDatalog, i, 0, &ui32Crc) != eDATALOG_ERROR_NONE)
+            continue;
+
+        DataloggerGetChannelView(psDatalog, &sView, i);
+        ui32Bytes = DataloggerViewGetLength(&sView);
+
+        for (uint16_t b = 0; DataloggerGetBlockCrc(psDatalog, i, b, &ui32Crc) == eDATALOG_ERROR_NONE; b++)
+        {
+            uint32_t ui32Pos = (uint32_t)b * DATALOGGER_CRC_BLOCK_SIZE;
+            uint32_t ui32Len = ui32Bytes - ui32Pos;
+
+            if (ui32Len > DATALOGGER_CRC_BLOCK_SIZE)
+                ui32Len = DATALOGGER_CRC_BLOCK_SIZE;
+
+            if (DataloggerCrc32Update(DATALOGGER_CRC32_INIT, &sView.pui8Base[ui32Pos], ui32Len) != ui32Crc)
+            {
+                ui8Bad |= (1 << (i - 1));
+                break;
+            }
+        }
+    }
+
+    if (pui8BadChannels != NULL)
+        *pui8BadChannels = ui8Bad;
+
+    return ui8Bad ? eDATALOG_ERROR_CRC : eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Sets the sample format of a channel view.
+ ***********************************************************************************/
+static void _DataloggerViewFormat (tDATALOGGER *psDatalog, tDATALOG_CHANNEL_VIEW *pView, uint8_t ui8Idx)
+{
+    tDATALOG_CHANNEL *pChannel = &psDatalog->sDatalogControl.sDatalogChannels[ui8Idx];
+
+    if (psDatalog->sGather.ui8Channels & (1 << ui8Idx))
+    {
+        pView->ui16Stride = pChannel->ui8ByteCount;
+        pView->ui8Width = pChannel->ui8ByteCount;
+        pView->ui8BitWidth = pChannel->ui8ByteCount << 3;
+        pView->eEncoding = eDATALOG_ENCODING_NATIVE;
+    }
+    else if (pChannel->ui8BitWidth)
+    {
+        pView->ui16Stride = 0;
+        pView->ui8Width = (pChannel->ui8BitWidth + 7) >> 3;
+        pView->ui8BitWidth = pChannel->ui8BitWidth;
+        pView->eEncoding = eDATALOG_ENCODING_BITPACKED;
+    }
+    else
+    {
+        pView->ui16Stride = pChannel->ui8ByteCount;
+        pView->ui8Width = pChannel->ui8ByteCount;
+        pView->ui8BitWidth = pChannel->ui8ByteCount << 3;
+        pView->eEncoding = eDATALOG_ENCODING_BE;
+    }
+}
+
+//===================================================================================
+uint32_t DataloggerViewGetLength(const tDATALOG_CHANNEL_VIEW *pView)
+{
+    // Bit streams are flushed in whole 32 bit words
+    if (pView->eEncoding == eDATALOG_ENCODING_BITPACKED)
+        return (uint32_t)((((uint64_t)pView->ui32Count * pView->ui8BitWidth + 31) >> 5) << 2);
+
+    return pView->ui32Count * pView->ui8Width;
+}
+
+//===================================================================================
+uint64_t DataloggerViewGetSample(const tDATALOG_CHANNEL_VIEW *pView, uint32_t ui32Idx)
+{
+    const uint8_t *pui8Sample;
+    uint64_t ui64Val = 0;
+
+    if (pView->eEncoding == eDATALOG_ENCODING_BITPACKED)
+    {
+        // Sample spans at most 5 bytes of the MSB first bit stream
+        uint32_t ui32BitPos = ui32Idx * pView->ui8BitWidth;
+        uint8_t ui8Bytes = ((ui32BitPos & 7) + pView->ui8BitWidth + 7) >> 3;
+
+        pui8Sample = &pView->pui8Base[ui32BitPos >> 3];
+
+        for (uint8_t j = 0; j < ui8Bytes; j++)
+            ui64Val = (ui64Val << 8) | pui8Sample[j];
+
+        ui64Val >>= (ui8Bytes << 3) - (ui32BitPos & 7) - pView->ui8BitWidth;
+
+        return ui64Val & (((uint64_t)1 << pView->ui8BitWidth) - 1);
+    }
+
+    pui8Sample = DATALOGGER_VIEW_SAMPLE_PTR(pView, ui32Idx);
+
+    if (pView->eEncoding == eDATALOG_ENCODING_NATIVE)
+    {
+        for (uint8_t j = pView->ui8Width; j > 0; j--)
+            ui64Val = (ui64Val << 8) | pui8Sample[j - 1];
+
+        return ui64Val;
+    }
+
+    for (uint8_t j = 0; j < pView->ui8Width; j++)
+        ui64Val = (ui64Val << 8) | pui8Sample[j];
+
+    return ui64Val;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerViewUnpack(const tDATALOG_CHANNEL_VIEW *pView, uint32_t *pui32Dst, uint32_t ui32Start, uint32_t ui32Count)
+{
+    const uint8_t *pui8Word;
+    uint64_t ui64Acc;
+    uint32_t ui32BitPos;
+    uint32_t ui32Mask;
+    uint8_t ui8Fill;
+
+    if (ui32Start > pView->ui32Count || ui32Count > pView->ui32Count - ui32Start)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    if (pView->eEncoding != eDATALOG_ENCODING_BITPACKED)
+    {
+        for (uint32_t i = 0; i < ui32Count; i++)
+            pui32Dst[i] = (uint32_t)DataloggerViewGetSample(pView, ui32Start + i);
+
+        return eDATALOG_ERROR_NONE;
+    }
+
+    if (ui32Count == 0)
+        return eDATALOG_ERROR_NONE;
+
+    // The bit stream consists of whole big endian words, start with the word 
+    // holding the first sample
+    ui32BitPos = ui32Start * pView->ui8BitWidth;
+    ui32Mask = (pView->ui8BitWidth == 32) ? 0xFFFFFFFF : ((uint32_t)1 << pView->ui8BitWidth) - 1;
+    pui8Word = &pView->pui8Base[(ui32BitPos >> 5) << 2];
+    ui64Acc = 0;
+    ui8Fill = 0;
+
+    // Bits of the first word preceding the start sample are skipped
+    ui32BitPos &= 31;
+
+    for (uint32_t i = 0; i < ui32Count; i++)
+    {
+        if (ui8Fill < pView->ui8BitWidth)
+        {
+            ui64Acc = (ui64Acc << 32) | ((uint32_t)pui8Word[0] << 24) | ((uint32_t)pui8Word[1] << 16) |
+                                        ((uint32_t)pui8Word[2] << 8) | (uint32_t)pui8Word[3];
+            ui8Fill += 32 - ui32BitPos;
+            ui32BitPos = 0;
+            pui8Word += 4;
+        }
+
+        ui8Fill -= pView->ui8BitWidth;
+        pui32Dst[i] = (uint32_t)(ui64Acc >> ui8Fill) & ui32Mask;
+    }
 
     return eDATALOG_ERROR_NONE;
 }
 
+//===================================================================================
+tDATALOGGER_VERSION DataloggerGetVersion(tDATALOGGER *psDatalog)
+{
+    return psDatalog->sVersion;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerRegisterLog (tDATALOGGER *psDatalog, uint32_t ui32ChID, uint8_t ui8LogNum, uint16_t ui16FreqDiv, uint32_t ui32RecLen, uint8_t *pui8Variable, uint8_t ui8ByteCount)
+{
+    return _DataloggerRegisterChannel(psDatalog, ui32ChID, ui8LogNum, ui16FreqDiv, ui32RecLen, pui8Variable, ui8ByteCount, 0);
+}
+
 //===================================================================================
 tDATALOG_ERROR DataloggerRemoveLog (tDATALOGGER *psDatalog, uint8_t ui8LogNum)
 {
-    if (ui8LogNum > MAX_NUM_LOGS)
+    if (ui8LogNum == 0 || ui8LogNum > MAX_NUM_LOGS)
         return eDATALOG_ERROR_LOG_NUMBER_INVALID;
 
+    // Check if datalogger tasks are going on
+    switch(psDatalog->eDatalogState)
+    {
+        case eDLOGSTATE_RUNNING:
+        case eDLOGSTATE_FORMAT_MEMORY:
+        case eDLOGSTATE_ABORTING:
+            return eDATALOG_ERROR_WRONG_STATE;
+        
+        default:
+            break;
+    }
+
     if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << (ui8LogNum - 1)) ))
         return eDATALOG_ERROR_CHANNEL_NOT_ACTIVE;
 
     psDatalog->sDatalogControl.ui8ActiveLoggers &= ~(1 << (ui8LogNum - 1));
+    psDatalog->sDatalogControl.ui8GetterChannels &= ~(1 << (ui8LogNum - 1));
+
+    // Offsets of the following channels change
+    psDatalog->sDatalogControl.ui8LayoutDirty |= (1 << (ui8LogNum - 1));
 
     DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_UNINITIALIZED);
 
@@ -243,281 +594,2080 @@ tDATALOG_ERROR DataloggerRemoveLog (tDATALOGGER *psDatalog, uint8_t ui8LogNum)
 }
 
 //===================================================================================
-// Function: DatalogInitialize
+tDATALOG_ERROR DataloggerRegisterBitLog (tDATALOGGER *psDatalog, uint32_t ui32ChID, uint8_t ui8LogNum, uint16_t ui16FreqDiv, uint32_t ui32RecLen, uint8_t *pui8Variable, uint8_t ui8ByteCount, uint32_t ui32BitMask)
+{
+    if (ui32BitMask == 0 || ui8ByteCount == 0 || ui8ByteCount > 4)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    // Mask bits must be part of the variable
+    if (ui8ByteCount < 4 && (ui32BitMask >> (ui8ByteCount << 3)))
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    return _DataloggerRegisterChannel(psDatalog, ui32ChID, ui8LogNum, ui16FreqDiv, ui32RecLen, pui8Variable, ui8ByteCount, ui32BitMask);
+}
+
 //===================================================================================
-/********************************************************************************//**
- * \brief Initialzes the Datalogger for a datalog run.
- *
- * This funciton must be called prior to start the datalogger. The memory is
- * initialized depending on the selected log configuration. 
- *
- * @param   sDatalogConfig Desired configuration of the datalogger.
- * @returns Error indicator
- ***********************************************************************************/
-tDATALOG_ERROR DataloggerInitLogger (tDATALOGGER *psDatalog, bool bFreeMemory)
+tDATALOG_ERROR DataloggerRegisterPackedLog (tDATALOGGER *psDatalog, uint32_t ui32ChID, uint8_t ui8LogNum, uint16_t ui16FreqDiv, uint32_t ui32RecLen, uint8_t *pui8Variable, uint8_t ui8ByteCount, uint8_t ui8BitWidth)
 {
-    uint16_t    ui16TempSize;
-    uint8_t     i = 0;
-    uint8_t     ui8LogCount = 0;
-    uint8_t     ui8LogIdx[MAX_NUM_LOGS] = {0};
-    uint32_t   ui32CurrentByteSize = 0;
-    tDATALOG_CHANNEL *pChannel = &psDatalog->sDatalogControl.sDatalogChannels[0];
+    if (ui8BitWidth == 0 || ui8BitWidth > 32)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
 
-    // Get out of this function if the state is not correct
-    if (psDatalog->eDatalogState != eDLOGSTATE_UNINITIALIZED)
-        return eDATALOG_ERROR_WRONG_STATE;
+    return DataloggerRegisterBitLog(psDatalog, ui32ChID, ui8LogNum, ui16FreqDiv, ui32RecLen, pui8Variable, ui8ByteCount, 
+                                    (ui8BitWidth == 32) ? 0xFFFFFFFF : ((uint32_t)1 << ui8BitWidth) - 1);
+}
 
+//===================================================================================
+tDATALOG_ERROR DataloggerRegisterGetterLog (tDATALOGGER *psDatalog, uint32_t ui32ChID, uint8_t ui8LogNum, uint16_t ui16FreqDiv, uint32_t ui32RecLen, tDATALOG_GETTER pfnGetter, void *pvCtx, uint8_t ui8ByteCount)
+{
+    tDATALOG_ERROR eError;
 
-    /********************************************************************************
-     * Free former memory allocation
-     *******************************************************************************/
+    if (pfnGetter == NULL || ui8ByteCount == 0 || ui8ByteCount > 8)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
 
-    if (bFreeMemory)
-        _DataloggerClearMemory(psDatalog);
+    eError = _DataloggerRegisterChannel(psDatalog, ui32ChID, ui8LogNum, ui16FreqDiv, ui32RecLen, NULL, ui8ByteCount, 0);
 
-    // Preinitialize Datalog structure
-    for(i = 0; i < MAX_NUM_LOGS; i++)
-    {
-        if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << i)))
-            continue;
+    if (eError != eDATALOG_ERROR_NONE)
+        return eError;
 
-        ui8LogIdx[ui8LogCount] = i;
+    psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1].pfnGetter = pfnGetter;
+    psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1].pvGetterCtx = pvCtx;
+    psDatalog->sDatalogControl.ui8GetterChannels |= (1 << (ui8LogNum - 1));
 
-        // Determine the offset of the current channel in external memory
-        if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODEMEM || 
-            psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODERAM)
-        {
-            if (ui8LogCount > 0)
-            {
-                psDatalog->sMemoryHeader.sDatalogChannelsMemory[i].ui32MemoryOffset = 
-                psDatalog->sDatalogControl.sDatalogChannels[i].ui32MemoryOffset = 
-                    psDatalog->sDatalogControl.sDatalogChannels[ui8LogIdx[ui8LogCount - 1]].ui32MemoryOffset +
-                    psDatalog->sDatalogControl.sDatalogChannels[ui8LogIdx[ui8LogCount - 1]].ui32RecordLength *
-                    psDatalog->sDatalogControl.sDatalogChannels[ui8LogIdx[ui8LogCount - 1]].ui8ByteCount;
-            }
-            else
-            {
-                if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODEMEM )
-                {
-                    psDatalog->sMemoryHeader.sDatalogChannelsMemory[i].ui32MemoryOffset = 
-                    psDatalog->sDatalogControl.sDatalogChannels[i].ui32CurMemPos = MEMORY_HEADER_SIZE();
-                }
-                else
-                {
-                    psDatalog->sDatalogControl.sDatalogChannels[i].ui32MemoryOffset = 
-                    psDatalog->sDatalogControl.sDatalogChannels[i].ui32CurMemPos = 0;
-                }
-            }
+    // Drops the channel from the gather table (DataloggerInitLogger)
+    if (psDatalog->sGather.ui8Channels & (1 << (ui8LogNum - 1)))
+        DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_UNINITIALIZED);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerRegisterHistogramLog (tDATALOGGER *psDatalog, uint32_t ui32ChID, uint8_t ui8LogNum, uint16_t ui16FreqDiv, uint32_t ui32Bins, 
+                                               uint8_t *pui8Variable, uint8_t ui8ByteCount, bool bSigned, int32_t i32Min, uint8_t ui8BinShift)
+{
+    tDATALOG_CHANNEL *pChannel;
+    tDATALOG_ERROR eError;
+
+    if (pui8Variable == NULL || ui32Bins == 0 || ui8ByteCount == 0 || ui8ByteCount > 4 || ui8BinShift > 31)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    // The bins are stored as 32 bit counters
+    eError = _DataloggerRegisterChannel(psDatalog, ui32ChID, ui8LogNum, ui16FreqDiv, ui32Bins, pui8Variable, 4, 0);
+
+    if (eError != eDATALOG_ERROR_NONE)
+        return eError;
+
+    pChannel = &psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1];
+    pChannel->ui8HistByteCount = ui8ByteCount;
+    pChannel->ui8HistSigned = bSigned ? 1 : 0;
+    pChannel->ui8HistShift = ui8BinShift;
+    pChannel->i32HistMin = i32Min;
+
+    // Drops the channel from the gather table (DataloggerInitLogger)
+    if (psDatalog->sGather.ui8Channels & (1 << (ui8LogNum - 1)))
+        DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_UNINITIALIZED);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerSetChannelScaling (tDATALOGGER *psDatalog, uint8_t ui8LogNum, tDATALOG_SCALING sScaling)
+{
+    tDATALOG_CHANNEL *pChannel;
+
+    if (ui8LogNum == 0 || ui8LogNum > MAX_NUM_LOGS)
+        return eDATALOG_ERROR_LOG_NUMBER_INVALID;
+
+    if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << (ui8LogNum - 1)) ))
+        return eDATALOG_ERROR_CHANNEL_NOT_ACTIVE;
+
+    pChannel = &psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1];
+
+    // Only float and double are supported floating point types
+    if (sScaling.eType == eDATALOG_TYPE_FLOAT && pChannel->ui8ByteCount != 4 && pChannel->ui8ByteCount != 8)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    if (sScaling.eType > eDATALOG_TYPE_FLOAT)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    // Scaling does not affect the memory layout, no reinitialization needed
+    pChannel->sScaling = 
+    psDatalog->sMemoryHeader.sDatalogChannelsMemory[ui8LogNum - 1].sScaling = sScaling;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerGetChannelScaling (tDATALOGGER *psDatalog, tDATALOG_SCALING *pScaling, uint8_t ui8LogNum)
+{
+    if (ui8LogNum == 0 || ui8LogNum > MAX_NUM_LOGS)
+        return eDATALOG_ERROR_LOG_NUMBER_INVALID;
+
+    if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << (ui8LogNum - 1)) ))
+        return eDATALOG_ERROR_CHANNEL_NOT_ACTIVE;
+
+    *pScaling = psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1].sScaling;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerSetChannelGuard (tDATALOGGER *psDatalog, uint8_t ui8LogNum, const volatile uint32_t *pui32Seq)
+{
+#if DATALOGGER_CONSISTENT_READ
+    tDATALOG_CHANNEL *pChannel;
+
+    if (ui8LogNum == 0 || ui8LogNum > MAX_NUM_LOGS)
+        return eDATALOG_ERROR_LOG_NUMBER_INVALID;
+
+    if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << (ui8LogNum - 1))))
+        return eDATALOG_ERROR_CHANNEL_NOT_ACTIVE;
+
+    if (psDatalog->eDatalogState == eDLOGSTATE_RUNNING)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    pChannel = &psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1];
+
+    // Histogram and decimated channels read their variable directly, the last 
+    // consistent sample is kept in 64 bits
+    if (pChannel->ui8HistByteCount || (pChannel->ui8CicOrder && pui32Seq != NULL) || pChannel->ui8ByteCount > 8)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    pChannel->pui32Guard = pui32Seq;
+    pChannel->ui64LastValue = 0;
+
+    return eDATALOG_ERROR_NONE;
+#else
+    (void)psDatalog;
+    (void)ui8LogNum;
+    (void)pui32Seq;
+
+    return eDATALOG_ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerSetChannelDecimation (tDATALOGGER *psDatalog, uint8_t ui8LogNum, uint8_t ui8Order)
+{
+    tDATALOG_CHANNEL *pChannel;
+
+    if (ui8LogNum == 0 || ui8LogNum > MAX_NUM_LOGS)
+        return eDATALOG_ERROR_LOG_NUMBER_INVALID;
+
+    if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << (ui8LogNum - 1))))
+        return eDATALOG_ERROR_CHANNEL_NOT_ACTIVE;
+
+    // Check if datalogger tasks are going on
+    switch(psDatalog->eDatalogState)
+    {
+        case eDLOGSTATE_RUNNING:
+        case eDLOGSTATE_FORMAT_MEMORY:
+        case eDLOGSTATE_ABORTING:
+            return eDATALOG_ERROR_WRONG_STATE;
+        
+        default:
+            break;
+    }
+
+    pChannel = &psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1];
+
+    if (ui8Order > DATALOGGER_CIC_MAX_ORDER)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    // The filter needs the plain variable on every tick
+    if (ui8Order && (pChannel->ui8BitWidth || pChannel->pfnGetter != NULL || pChannel->ui8HistByteCount || 
+                     pChannel->pui32Guard != NULL || pChannel->ui8ByteCount > 4 ||
+                     !_DataloggerCicInRange(ui8Order, pChannel->ui16Divider, pChannel->ui8ByteCount)))
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    pChannel->ui8CicOrder = ui8Order;
+
+    // Drops the channel from the gather table (DataloggerInitLogger)
+    if (psDatalog->sGather.ui8Channels & (1 << (ui8LogNum - 1)))
+        DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_UNINITIALIZED);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerSetGather (tDATALOGGER *psDatalog, tDATALOG_GATHER_CB pfnGather, void *pvCtx)
+{
+    // Check if datalogger tasks are going on
+    switch(psDatalog->eDatalogState)
+    {
+        case eDLOGSTATE_RUNNING:
+        case eDLOGSTATE_FORMAT_MEMORY:
+        case eDLOGSTATE_ABORTING:
+            return eDATALOG_ERROR_WRONG_STATE;
+        
+        default:
+            break;
+    }
+
+    psDatalog->sGather.pfnGather = pfnGather;
+    psDatalog->sGather.pvCtx = pvCtx;
+
+    // Descriptor table is built by the initialization
+    DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_UNINITIALIZED);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+void DataloggerGatherMemcpy (const tDATALOG_GATHER_DESC *psDesc, uint8_t ui8Count, void *pvCtx)
+{
+    (void)pvCtx;
+
+    for (uint8_t i = 0; i < ui8Count; i++)
+        memcpy(psDesc[i].pui8Dst, psDesc[i].pui8Src, psDesc[i].ui8Width);
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerSetTimebase (tDATALOGGER *psDatalog, uint8_t ui8Timebase, uint16_t ui16Ratio)
+{
+    if (ui8Timebase == 0 || ui8Timebase >= DATALOGGER_MAX_TIMEBASES || ui16Ratio == 0)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    // Check if datalogger tasks are going on
+    switch(psDatalog->eDatalogState)
+    {
+        case eDLOGSTATE_RUNNING:
+        case eDLOGSTATE_FORMAT_MEMORY:
+        case eDLOGSTATE_ABORTING:
+            return eDATALOG_ERROR_WRONG_STATE;
+        
+        default:
+            break;
+    }
+
+    psDatalog->sTimebases.ui16Ratio[ui8Timebase] = ui16Ratio;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerSetChannelTimebase (tDATALOGGER *psDatalog, uint8_t ui8LogNum, uint8_t ui8Timebase)
+{
+    if (ui8LogNum == 0 || ui8LogNum > MAX_NUM_LOGS)
+        return eDATALOG_ERROR_LOG_NUMBER_INVALID;
+
+    if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << (ui8LogNum - 1))))
+        return eDATALOG_ERROR_CHANNEL_NOT_ACTIVE;
+
+    if (ui8Timebase >= DATALOGGER_MAX_TIMEBASES || psDatalog->sTimebases.ui16Ratio[ui8Timebase] == 0)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    // Check if datalogger tasks are going on
+    switch(psDatalog->eDatalogState)
+    {
+        case eDLOGSTATE_RUNNING:
+        case eDLOGSTATE_FORMAT_MEMORY:
+        case eDLOGSTATE_ABORTING:
+            return eDATALOG_ERROR_WRONG_STATE;
+        
+        default:
+            break;
+    }
+
+    for (uint8_t k = 0; k < DATALOGGER_MAX_TIMEBASES; k++)
+        psDatalog->sTimebases.ui8Channels[k] &= ~(1 << (ui8LogNum - 1));
+
+    psDatalog->sTimebases.ui8Channels[ui8Timebase] |= (1 << (ui8LogNum - 1));
+
+    // The gather table only covers the base timebase
+    DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_UNINITIALIZED);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerSetChannelDivider (tDATALOGGER *psDatalog, uint8_t ui8LogNum, uint16_t ui16Divider)
+{
+    if (ui16Divider == 0)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    return _DataloggerRequestRateChange(psDatalog, ui8LogNum, ui16Divider);
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerStopChannel (tDATALOGGER *psDatalog, uint8_t ui8LogNum)
+{
+    return _DataloggerRequestRateChange(psDatalog, ui8LogNum, 0);
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerSetSequence (tDATALOGGER *psDatalog, uint16_t ui16Segments, tDATALOG_SEQMODE eRearmMode)
+{
+    // Check if datalogger tasks are going on
+    switch(psDatalog->eDatalogState)
+    {
+        case eDLOGSTATE_RUNNING:
+        case eDLOGSTATE_FORMAT_MEMORY:
+        case eDLOGSTATE_ABORTING:
+            return eDATALOG_ERROR_WRONG_STATE;
+        
+        default:
+            break;
+    }
+
+    if (ui16Segments == 0 || ui16Segments > DATALOGGER_MAX_SEGMENTS)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    if (eRearmMode != eSEQMODE_IMMEDIATE && eRearmMode != eSEQMODE_TRIGGERED && eRearmMode != eSEQMODE_RING)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    if (eRearmMode == eSEQMODE_RING && ui16Segments != 1)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    psDatalog->sSequence.ui16SegmentCount = ui16Segments;
+    psDatalog->sSequence.eRearmMode = eRearmMode;
+
+    // Segment lengths must be recalculated
+    DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_UNINITIALIZED);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerTrigger (tDATALOGGER *psDatalog)
+{
+    if (psDatalog->eDatalogState != eDLOGSTATE_RUNNING)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    psDatalog->sSequence.ui8TriggerPending = 1;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerGetSegmentInfo (tDATALOGGER *psDatalog, tDATALOG_SEGMENT *pSegment, uint16_t ui16SegNum)
+{
+    tDATALOG_SEGMENT_TABLE *pTable;
+
+    if (!_DataloggerReadoutAvailable(psDatalog))
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    pTable = &psDatalog->sSequence.sTables[psDatalog->sDatalogControl.ui8ReadoutBufIdx];
+
+    if (ui16SegNum >= pTable->ui16Count)
+        return eDATALOG_ERROR_NO_DATA;
+
+    *pSegment = pTable->sSegments[ui16SegNum];
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerGetRateMarker (tDATALOGGER *psDatalog, tDATALOG_RATE_MARKER *pMarker, uint16_t ui16MarkerNum)
+{
+    tDATALOG_SEGMENT_TABLE *pTable;
+
+    if (!_DataloggerReadoutAvailable(psDatalog))
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    pTable = &psDatalog->sSequence.sTables[psDatalog->sDatalogControl.ui8ReadoutBufIdx];
+
+    if (ui16MarkerNum >= pTable->ui16MarkerCount)
+        return eDATALOG_ERROR_NO_DATA;
+
+    *pMarker = pTable->sMarkers[ui16MarkerNum];
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerGetCaptureDivider (tDATALOGGER *psDatalog, uint8_t ui8ChNum, uint16_t *pui16Divider)
+{
+    if (!_DataloggerReadoutAvailable(psDatalog))
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    if (ui8ChNum == 0 || ui8ChNum > MAX_NUM_LOGS)
+        return eDATALOG_ERROR_LOG_NUMBER_INVALID;
+
+    if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << (ui8ChNum - 1))))
+        return eDATALOG_ERROR_CHANNEL_NOT_ACTIVE;
+
+    *pui16Divider = psDatalog->sSequence.sTables[psDatalog->sDatalogControl.ui8ReadoutBufIdx].ui16Divider[ui8ChNum - 1];
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerGetSampleTick (tDATALOGGER *psDatalog, uint8_t ui8ChNum, uint32_t ui32Idx, uint32_t *pui32Tick)
+{
+    tDATALOG_SEGMENT_TABLE *pTable;
+    tDATALOG_CHANNEL *pChannel;
+    uint32_t ui32Seg;
+    uint32_t ui32BaseTick;
+    uint32_t ui32BaseIdx;
+    uint32_t ui32Divider;
+    bool bChanged = false;
+
+    if (!_DataloggerReadoutAvailable(psDatalog))
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    if (ui8ChNum == 0 || ui8ChNum > MAX_NUM_LOGS)
+        return eDATALOG_ERROR_LOG_NUMBER_INVALID;
+
+    if (ui32Idx >= psDatalog->sDatalogControl.ui32ReadoutCount[ui8ChNum - 1])
+        return eDATALOG_ERROR_NO_DATA;
+
+    pTable = &psDatalog->sSequence.sTables[psDatalog->sDatalogControl.ui8ReadoutBufIdx];
+    pChannel = &psDatalog->sDatalogControl.sDatalogChannels[ui8ChNum - 1];
+
+    // Every segment starts with a sample, followed by one sample each divider ticks
+    ui32Seg = ui32Idx / pChannel->ui32SegmentLength;
+
+    if (ui32Seg >= pTable->ui16Count)
+        return eDATALOG_ERROR_NO_DATA;
+
+    ui32BaseTick = pTable->sSegments[ui32Seg].ui32StartTick;
+    ui32BaseIdx = ui32Seg * pChannel->ui32SegmentLength;
+    ui32Divider = (uint32_t)pTable->ui16Divider[ui8ChNum - 1] * _DataloggerTimebaseRatio(psDatalog, ui8ChNum - 1);
+
+    // Divider changes during the run: Continue from the last marker before the sample
+    for (uint16_t m = 0; m < pTable->ui16MarkerCount; m++)
+    {
+        tDATALOG_RATE_MARKER *pMarker = &pTable->sMarkers[m];
+
+        if (pMarker->ui8LogNum != ui8ChNum)
+            continue;
+
+        if (!bChanged)
+        {
+            ui32Divider = (uint32_t)pMarker->ui16OldDivider * _DataloggerTimebaseRatio(psDatalog, ui8ChNum - 1);
+            bChanged = true;
+        }
+
+        if (pMarker->ui32SampleIdx > ui32Idx)
+            break;
+
+        ui32Divider = (uint32_t)pMarker->ui16Divider * _DataloggerTimebaseRatio(psDatalog, ui8ChNum - 1);
+
+        if (pMarker->ui32SampleIdx >= ui32BaseIdx)
+        {
+            ui32BaseTick = pMarker->ui32Tick;
+            ui32BaseIdx = pMarker->ui32SampleIdx;
+        }
+    }
+
+    *pui32Tick = ui32BaseTick + (ui32Idx - ui32BaseIdx) * ui32Divider;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+// Function: DatalogInitialize
+//===================================================================================
+/********************************************************************************//**
+ * \brief Initialzes the Datalogger for a datalog run.
+ *
+ * This funciton must be called prior to start the datalogger. The memory is
+ * initialized depending on the selected log configuration. 
+ *
+ * Only the offsets from the first changed channel on are recalculated. In RAM 
+ * mode the capture buffers are kept as long as the new layout fits into them.
+ *
+ * @param   sDatalogConfig Desired configuration of the datalogger.
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerInitLogger (tDATALOGGER *psDatalog, bool bFreeMemory)
+{
+    uint16_t    ui16TempSize;
+    uint8_t     ui8FirstDirty = 0;
+    uint8_t     i = 0;
+    uint8_t     ui8LogCount = 0;
+    uint8_t     ui8LogIdx[MAX_NUM_LOGS] = {0};
+    uint32_t   ui32CurrentByteSize = 0;
+#if DATALOGGER_CRC_BLOCK_SIZE
+    uint16_t    ui16CrcBlocks = 0;
+#endif
+    tDATALOG_CHANNEL *pChannel = &psDatalog->sDatalogControl.sDatalogChannels[0];
+
+    // Get out of this function if the state is not correct
+    if (psDatalog->eDatalogState != eDLOGSTATE_UNINITIALIZED)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    // Captures in use must not be freed
+    if (psDatalog->sDatalogControl.ui8ReadoutLocks)
+        return eDATALOG_ERROR_BUFFER_LOCKED;
+
+    /********************************************************************************
+     * Free former memory allocation
+     *******************************************************************************/
+
+    // RAM captures reuse their buffers if they are large enough
+    if (bFreeMemory && !CAPTURE_BUFFER_MODE(psDatalog))
+        _DataloggerClearMemory(psDatalog);
+
+    // Channels in front of the first changed channel keep their offsets
+    while (ui8FirstDirty < MAX_NUM_LOGS && !(psDatalog->sDatalogControl.ui8LayoutDirty & (1 << ui8FirstDirty)))
+        ui8FirstDirty++;
+
+    if (!CAPTURE_BUFFER_MODE(psDatalog))
+        ui8FirstDirty = 0;
+
+    // Preinitialize Datalog structure
+    for(i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << i)))
+            continue;
+
+        ui8LogIdx[ui8LogCount] = i;
+
+        // Ring buffers wrap at sample boundaries
+        if (psDatalog->sSequence.eRearmMode == eSEQMODE_RING && psDatalog->sDatalogControl.sDatalogChannels[i].ui8BitWidth)
+            return eDATALOG_ERROR_INVALID_PARAMETER;
+
+        // Replay needs a variable to write to
+        if (psDatalog->sDatalogControl.eOpMode == eOPMODE_REPLAY && 
+            psDatalog->sDatalogControl.sDatalogChannels[i].pfnGetter != NULL)
+            return eDATALOG_ERROR_INVALID_PARAMETER;
+
+        // Histograms count into the capture buffer until the run is stopped
+        if (psDatalog->sDatalogControl.sDatalogChannels[i].ui8HistByteCount)
+        {
+            if (psDatalog->sDatalogControl.eOpMode != eOPMODE_RECMODERAM)
+                return eDATALOG_ERROR_WRONG_OPMODE;
+
+            if (psDatalog->sSequence.ui16SegmentCount > 1)
+                return eDATALOG_ERROR_INVALID_PARAMETER;
+        }
+
+        // Decimation filters sample the variable
+        if (psDatalog->sDatalogControl.sDatalogChannels[i].ui8CicOrder && 
+            psDatalog->sDatalogControl.eOpMode != eOPMODE_RECMODERAM && 
+            psDatalog->sDatalogControl.eOpMode != eOPMODE_RECMODEMEM)
+            return eDATALOG_ERROR_WRONG_OPMODE;
+
+        // Determine the offset of the current channel in external memory
+        if (i >= ui8FirstDirty && (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODEMEM || 
+            CAPTURE_BUFFER_MODE(psDatalog)))
+        {
+            if (ui8LogCount > 0)
+            {
+                psDatalog->sMemoryHeader.sDatalogChannelsMemory[i].ui32MemoryOffset = 
+                psDatalog->sDatalogControl.sDatalogChannels[i].ui32MemoryOffset = 
+                    psDatalog->sDatalogControl.sDatalogChannels[ui8LogIdx[ui8LogCount - 1]].ui32MemoryOffset +
+                    _DataloggerChannelByteSize(&psDatalog->sDatalogControl.sDatalogChannels[ui8LogIdx[ui8LogCount - 1]]);
+            }
+            else
+            {
+                if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODEMEM )
+                {
+                    psDatalog->sMemoryHeader.sDatalogChannelsMemory[i].ui32MemoryOffset = 
+                    psDatalog->sDatalogControl.sDatalogChannels[i].ui32CurMemPos = MEMORY_HEADER_SIZE();
+                }
+                else
+                {
+                    psDatalog->sDatalogControl.sDatalogChannels[i].ui32MemoryOffset = 
+                    psDatalog->sDatalogControl.sDatalogChannels[i].ui32CurMemPos = 0;
+                }
+            }
+        }
+
+        ui32CurrentByteSize += _DataloggerChannelByteSize(&psDatalog->sDatalogControl.sDatalogChannels[i]);
+
+#if DATALOGGER_CRC_BLOCK_SIZE
+        // Every channel starts with a new CRC block
+        psDatalog->sDatalogControl.sDatalogChannels[i].ui16CrcFirstBlock = ui16CrcBlocks;
+        ui16CrcBlocks += (uint16_t)((_DataloggerChannelByteSize(&psDatalog->sDatalogControl.sDatalogChannels[i]) + 
+                                     DATALOGGER_CRC_BLOCK_SIZE - 1) / DATALOGGER_CRC_BLOCK_SIZE);
+#endif
+
+        // Every segment gets an equal slice of the record length
+        psDatalog->sDatalogControl.sDatalogChannels[i].ui32SegmentLength = 
+            psDatalog->sDatalogControl.sDatalogChannels[i].ui32RecordLength / psDatalog->sSequence.ui16SegmentCount;
+
+        if (psDatalog->sDatalogControl.sDatalogChannels[i].ui32SegmentLength == 0)
+            return eDATALOG_ERROR_INVALID_PARAMETER;
+
+        ui8LogCount++;
+    }
+
+
+    /********************************************************************************
+     * RAM initialization routines
+     *******************************************************************************/
+    if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODEMEM)
+    {
+        // temporary buffer is always set to max size
+        ui16TempSize = DATALOGGER_MAX_BUFFER_SIZE / (ui8LogCount << 1);
+
+        for(i = 0; i < ui8LogCount; i++)
+        {
+            pChannel = &psDatalog->sDatalogControl.sDatalogChannels[ui8LogIdx[i]];
+
+            pChannel->ui8RamBuf[0] = (uint8_t*)malloc((size_t)(ui16TempSize));
+            pChannel->ui8RamBuf[1] = (uint8_t*)malloc((size_t)(ui16TempSize));
+
+            // Retrieve data whenn the index exceeds half of the memory size
+            pChannel->ui16RetrieveThreshIdx = ui16TempSize >> 2;
+
+            // Flag that the memory of this channel has been acquired
+            psDatalog->sDatalogControl.ui8MemoryAcquired |= (1 << ui8LogIdx[i]);
+            
+        }
+        // Note: pChannel still pointing on the last active memory channel
+        psDatalog->sMemoryHeader.ui32LastAddress = 
+            psDatalog->sMemoryHeader.sDatalogChannelsMemory[ui8LogIdx[ui8LogCount - 1]].ui32MemoryOffset + 
+            pChannel->ui32RecordLength - 1;
+
+        psDatalog->sMemoryHeader.ui32TimeBase = psDatalog->sNVPar.ui32EE_TimeBase_Hz;
+    }
+    else if (CAPTURE_BUFFER_MODE(psDatalog))
+    {
+        if (ui32CurrentByteSize > DATALOGGER_MAX_BUFFER_SIZE)
+            return eDATALOG_ERROR_NOT_ENOUGH_MEMORY;
+
+        // Reallocation only if the capture buffers are too small
+        if (!psDatalog->sDatalogControl.ui8MemoryAcquired || ui32CurrentByteSize > psDatalog->sDatalogControl.ui32MemCapacity)
+        {
+            _DataloggerClearMemory(psDatalog);
+
+            psDatalog->sDatalogControl.ui8MemoryAcquired = 1;
+            psDatalog->sDatalogControl.ui32MemCapacity = ui32CurrentByteSize;
+
+            // Every capture buffer holds one complete capture
+            for (i = 0; i < DATALOGGER_CAPTURE_BUFFERS; i++)
+            {
+                psDatalog->sDatalogControl.pui8CaptureBuf[i] = (uint8_t*)calloc((size_t)ui32CurrentByteSize, 1);
+
+                if (psDatalog->sDatalogControl.pui8CaptureBuf[i] == NULL)
+                    return eDATALOG_ERROR_MEMORY_ALLOCATION_FAILED;
+            }
+        }
+
+        psDatalog->sDatalogControl.ui8CaptureBufIdx = 0;
+        psDatalog->sDatalogControl.pui8Data = psDatalog->sDatalogControl.pui8CaptureBuf[0];
+        psDatalog->sDatalogControl.pui8ReadoutData = NULL;
+    }
+
+    psDatalog->sDatalogControl.ui32MemLen = ui32CurrentByteSize;
+    psDatalog->sDatalogControl.ui8LayoutDirty = 0;
+
+    /********************************************************************************
+     * Gather descriptor table
+     *******************************************************************************/
+    // The table only covers plain variables of timebase 0. A channel which turns 
+    // into a getter, histogram or decimated channel leaves it with the next 
+    // initialization, until then the logger is uninitialized.
+    psDatalog->sGather.ui8Channels = 0;
+
+    if (psDatalog->sGather.pfnGather != NULL && psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODERAM)
+    {
+        for (i = 0; i < MAX_NUM_LOGS; i++)
+        {
+            pChannel = &psDatalog->sDatalogControl.sDatalogChannels[i];
+
+            if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & psDatalog->sTimebases.ui8Channels[0] & (1 << i)) || 
+                pChannel->ui8BitWidth || pChannel->pui32Guard != NULL || pChannel->pfnGetter != NULL ||
+                pChannel->ui8HistByteCount || pChannel->ui8CicOrder)
+                continue;
+
+            // Target address is completed per tick (capture buffer + current position)
+            psDatalog->sGather.sTable[i].pui8Src = pChannel->pui8Variable;
+            psDatalog->sGather.sTable[i].pui8Dst = NULL;
+            psDatalog->sGather.sTable[i].ui8Width = pChannel->ui8ByteCount;
+            psDatalog->sGather.ui8Channels |= (1 << i);
+        }
+    }
+    /********************************************************************************
+     * State control
+     *******************************************************************************/
+    
+    //TODO: LIVEMODE Ringbuffer initialization
+
+    if (psDatalog->sDatalogControl.eOpMode != eOPMODE_RECMODEMEM)
+    {
+        DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_INITIALIZED);
+        // psDatalog->eDatalogStatePending = eDLOGSTATE_INITIALIZED;
+    }
+    else 
+    {
+        DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_FORMAT_MEMORY);
+        // psDatalog->eDatalogStatePending = eDLOGSTATE_FORMAT_MEMORY;
+    }
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerGetBudget (tDATALOGGER *psDatalog, tDATALOG_BUDGET *pBudget)
+{
+    uint32_t ui32Required = 0;
+
+    if (psDatalog->sDatalogControl.eOpMode != eOPMODE_RECMODERAM)
+        return eDATALOG_ERROR_NOT_IMPLEMENTED;
+
+    for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        if (psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << i))
+            ui32Required += _DataloggerChannelByteSize(&psDatalog->sDatalogControl.sDatalogChannels[i]);
+    }
+
+    pBudget->ui32Capacity = DATALOGGER_MAX_BUFFER_SIZE;
+    pBudget->ui32Required = ui32Required;
+    pBudget->i32Remaining = (int32_t)pBudget->ui32Capacity - (int32_t)ui32Required;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerPlanRecordLengths (tDATALOGGER *psDatalog, tDATALOG_SIZING eMode, const uint8_t *pui8Weights, uint32_t *pui32RecLen)
+{
+    tDATALOG_CHANNEL *pChannel = psDatalog->sDatalogControl.sDatalogChannels;
+    uint8_t ui8Active = psDatalog->sDatalogControl.ui8ActiveLoggers;
+    uint32_t ui32Capacity = DATALOGGER_MAX_BUFFER_SIZE;
+    uint32_t ui32Used = 0;
+    uint32_t ui32WeightSum = 0;
+    uint8_t i;
+
+    if (psDatalog->sDatalogControl.eOpMode != eOPMODE_RECMODERAM)
+        return eDATALOG_ERROR_NOT_IMPLEMENTED;
+
+    if (!ui8Active)
+        return eDATALOG_ERROR_CHANNEL_NOT_ACTIVE;
+
+    for (i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        pui32RecLen[i] = 0;
+
+        if ((ui8Active & (1 << i)) && pui8Weights != NULL)
+            ui32WeightSum += pui8Weights[i];
+    }
+
+    if (eMode == eSIZING_EQUAL_TIME)
+    {
+        // Binary search for the longest time span (in service ticks) that fits
+        uint64_t ui64Lo = 0;
+        uint64_t ui64Hi = 0;
+
+        for (i = 0; i < MAX_NUM_LOGS; i++)
+        {
+            if ((ui8Active & (1 << i)) && _DataloggerTickDivider(psDatalog, i) == 0)
+                return eDATALOG_ERROR_INVALID_PARAMETER;
+
+            if ((ui8Active & (1 << i)) && (uint64_t)_DataloggerTickDivider(psDatalog, i) * ui32Capacity * 8 > ui64Hi)
+                ui64Hi = (uint64_t)_DataloggerTickDivider(psDatalog, i) * ui32Capacity * 8;
+        }
+
+        while (ui64Lo < ui64Hi)
+        {
+            uint64_t ui64Mid = (ui64Lo + ui64Hi + 1) >> 1;
+            uint64_t ui64Bytes = 0;
+
+            for (i = 0; i < MAX_NUM_LOGS; i++)
+            {
+                if (ui8Active & (1 << i))
+                    ui64Bytes += _DataloggerPlannedByteSize(&pChannel[i], (uint32_t)(ui64Mid / _DataloggerTickDivider(psDatalog, i)));
+            }
+
+            if (ui64Bytes <= ui32Capacity)
+                ui64Lo = ui64Mid;
+            else
+                ui64Hi = ui64Mid - 1;
+        }
+
+        for (i = 0; i < MAX_NUM_LOGS; i++)
+        {
+            if (ui8Active & (1 << i))
+                pui32RecLen[i] = (uint32_t)(ui64Lo / _DataloggerTickDivider(psDatalog, i));
+        }
+    }
+    else if (eMode == eSIZING_WEIGHTED)
+    {
+        uint8_t ui8Count = 0;
+
+        for (i = 0; i < MAX_NUM_LOGS; i++)
+            ui8Count += (ui8Active >> i) & 1;
+
+        for (i = 0; i < MAX_NUM_LOGS; i++)
+        {
+            if (!(ui8Active & (1 << i)))
+                continue;
+
+            if (ui32WeightSum)
+                pui32RecLen[i] = _DataloggerMaxRecordLength(&pChannel[i], (uint32_t)((uint64_t)ui32Capacity * pui8Weights[i] / ui32WeightSum));
+            else
+                pui32RecLen[i] = _DataloggerMaxRecordLength(&pChannel[i], ui32Capacity / ui8Count);
+        }
+    }
+    else
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    for (i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        if (ui8Active & (1 << i))
+            ui32Used += _DataloggerPlannedByteSize(&pChannel[i], pui32RecLen[i]);
+    }
+
+    // Hand out the rounding remainder
+    for (i = 0; i < MAX_NUM_LOGS && ui32Used < ui32Capacity; i++)
+    {
+        uint32_t ui32Size;
+
+        if (!(ui8Active & (1 << i)))
+            continue;
+
+        ui32Size = _DataloggerPlannedByteSize(&pChannel[i], pui32RecLen[i]);
+        pui32RecLen[i] = _DataloggerMaxRecordLength(&pChannel[i], ui32Size + ui32Capacity - ui32Used);
+        ui32Used += _DataloggerPlannedByteSize(&pChannel[i], pui32RecLen[i]) - ui32Size;
+    }
+
+    // Every segment needs at least one sample
+    for (i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        if ((ui8Active & (1 << i)) && pui32RecLen[i] < psDatalog->sSequence.ui16SegmentCount)
+            return eDATALOG_ERROR_NOT_ENOUGH_MEMORY;
+    }
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerAutoSize (tDATALOGGER *psDatalog, tDATALOG_SIZING eMode, const uint8_t *pui8Weights)
+{
+    uint32_t ui32RecLen[MAX_NUM_LOGS];
+    tDATALOG_ERROR eError;
+
+    // Check if datalogger tasks are going on
+    switch(psDatalog->eDatalogState)
+    {
+        case eDLOGSTATE_RUNNING:
+        case eDLOGSTATE_FORMAT_MEMORY:
+        case eDLOGSTATE_ABORTING:
+            return eDATALOG_ERROR_WRONG_STATE;
+        
+        default:
+            break;
+    }
+
+    eError = DataloggerPlanRecordLengths(psDatalog, eMode, pui8Weights, ui32RecLen);
+
+    if (eError != eDATALOG_ERROR_NONE)
+        return eError;
+
+    for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << i)) || 
+            psDatalog->sDatalogControl.sDatalogChannels[i].ui32RecordLength == ui32RecLen[i])
+            continue;
+
+        psDatalog->sDatalogControl.sDatalogChannels[i].ui32RecordLength = ui32RecLen[i];
+        psDatalog->sDatalogControl.ui8LayoutDirty |= (1 << i);
+    }
+
+    if (psDatalog->sDatalogControl.ui8LayoutDirty)
+        DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_UNINITIALIZED);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+// Function: DatalogStart
+//===================================================================================
+/********************************************************************************//**
+ * \brief Starts the datalogger
+ *
+ * With A/B buffering, the datalogger can be restarted out of eDLOGSTATE_DATA_READY.
+ * The new run records into the other capture buffer while the completed capture
+ * stays available for readout.
+ *
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerStart (tDATALOGGER *psDatalog)
+{
+    uint8_t i = 0;
+    tDATALOG_CHANNEL* pChannel = psDatalog->sDatalogControl.sDatalogChannels;
+    tDATALOG_SEGMENT_TABLE *pTable;
+
+    switch(psDatalog->eDatalogState)
+    {
+        case eDLOGSTATE_INITIALIZED:
+            break;
+
+        case eDLOGSTATE_DATA_READY:
+            // A replay runs again over the same recorded data
+            if (psDatalog->sDatalogControl.eOpMode == eOPMODE_REPLAY)
+                break;
+
+#if DATALOGGER_CAPTURE_BUFFERS > 1
+            if (psDatalog->sDatalogControl.eOpMode != eOPMODE_RECMODERAM)
+                return eDATALOG_ERROR_WRONG_STATE;
+
+            if (psDatalog->sDatalogControl.ui8ReadoutLocks & (1 << (psDatalog->sDatalogControl.ui8CaptureBufIdx ^ 1)))
+                return eDATALOG_ERROR_BUFFER_LOCKED;
+
+            // Swap the capture buffers, the completed capture stays published
+            psDatalog->sDatalogControl.ui8CaptureBufIdx ^= 1;
+            psDatalog->sDatalogControl.pui8Data = 
+                psDatalog->sDatalogControl.pui8CaptureBuf[psDatalog->sDatalogControl.ui8CaptureBufIdx];
+            break;
+#else
+            return eDATALOG_ERROR_WRONG_STATE;
+#endif
+
+        default:
+            return eDATALOG_ERROR_WRONG_STATE;
+    }
+
+    pTable = &psDatalog->sSequence.sTables[psDatalog->sDatalogControl.ui8CaptureBufIdx];
+    pTable->ui8CrcChannels = 0;
+
+    // Resets all relevant variables
+    while (i < MAX_NUM_LOGS)
+    {
+        if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << i)))
+        {
+            i++;
+            continue;
+        }
+
+        // Divider changes of the last run are discarded
+        pChannel[i].ui16Divider = psDatalog->sMemoryHeader.sDatalogChannelsMemory[i].ui16Divider;
+        pTable->ui16Divider[i] = pChannel[i].ui16Divider;
+
+        // Reset of the state variables
+        pChannel[i].ui8BufNum = 0;
+        pChannel[i].ui16DivideCount = 1;
+        pChannel[i].ui16ValIdx = 0;
+        pChannel[i].ui32CurrentCount = 0;
+        pChannel[i].ui32SegmentEnd = 0;
+        pChannel[i].ui64BitAcc = 0;
+        pChannel[i].ui8BitFill = 0;
+
+        DATALOGGER_ATOMIC_STORE32(&pChannel[i].ui32CommittedCount, 0);
+
+#if DATALOGGER_CRC_BLOCK_SIZE
+        // Block CRCs of samples written by the service in sample order
+        pChannel[i].ui32Crc = DATALOGGER_CRC32_INIT;
+        pChannel[i].ui32CrcPos = 0;
+
+        if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODERAM && psDatalog->sSequence.eRearmMode != eSEQMODE_RING &&
+            !(psDatalog->sGather.ui8Channels & (1 << i)) && !pChannel[i].ui8HistByteCount)
+            pTable->ui8CrcChannels |= (1 << i);
+#endif
+
+        // Filters start from rest
+        pChannel[i].ui8CicWarmup = pChannel[i].ui8CicOrder;
+        memset(pChannel[i].ui64CicInteg, 0, sizeof(pChannel[i].ui64CicInteg));
+        memset(pChannel[i].ui64CicComb, 0, sizeof(pChannel[i].ui64CicComb));
+
+        // All bins are read out, counting starts from zero
+        if (pChannel[i].ui8HistByteCount)
+        {
+            pChannel[i].ui32CurrentCount = pChannel[i].ui32RecordLength;
+            memset(&psDatalog->sDatalogControl.pui8Data[pChannel[i].ui32MemoryOffset], 0, pChannel[i].ui32RecordLength << 2);
+            DATALOGGER_ATOMIC_STORE32(&pChannel[i].ui32CommittedCount, pChannel[i].ui32RecordLength);
+        }
+        
+        if(CAPTURE_BUFFER_MODE(psDatalog))
+        {
+            pChannel[i].ui32CurMemPos = psDatalog->sDatalogControl.sDatalogChannels[i].ui32MemoryOffset;
+            // psDatalog->sDatalogControl.ui32CurIdx = 0;
+        }
+        else if(psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODEMEM)
+        {
+            pChannel[i].ui32CurMemPos = psDatalog->sMemoryHeader.sDatalogChannelsMemory[i].ui32MemoryOffset;
+
+            // Reset the control variables of the serializer
+            psDatalog->sDatalogSerializer.ui8ArbitrationCount = 0;
+            psDatalog->sDatalogSerializer.ui8FillIdx = 0;
+            psDatalog->sDatalogSerializer.ui8RetrieveFlags = 0;
+            psDatalog->sDatalogSerializer.ui8RetrieveIdx = 0;
+        }
+
+        i++;
+    }
+
+    psDatalog->sDatalogControl.ui32TickCount = 0;
+    psDatalog->sSequence.ui16CurSegment = 0;
+    pTable->ui16Count = 0;
+    pTable->ui16MarkerCount = 0;
+    psDatalog->sDatalogControl.ui8ChannelsStopped = 0;
+    psDatalog->sDatalogControl.ui8RateChanges = 0;
+    psDatalog->sDatalogControl.ui8RingWrapped = 0;
+    psDatalog->sSequence.ui8TriggerPending = 0;
+
+    // Triggered runs wait for the first trigger, all others start right away
+    if (psDatalog->sSequence.eRearmMode == eSEQMODE_TRIGGERED)
+    {
+        psDatalog->sDatalogControl.ui8ChannelsRunning = 0;
+        psDatalog->sSequence.ui8Armed = 1;
+    }
+    else
+        _DataloggerStartSegment(psDatalog);
+
+    // Switch the datalog on (directly, because this is time critical)
+    DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_RUNNING);
+
+    if(psDatalog->sCallbacks.StartDataloggerCb != NULL)
+        psDatalog->sCallbacks.StartDataloggerCb();
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+// Function: DataloggerStop
+//===================================================================================
+/********************************************************************************//**
+ * \brief Stops the datalogger
+ *
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_STATE DataloggerStop (tDATALOGGER *psDatalog)
+{
+    if (psDatalog->eDatalogState != eDLOGSTATE_RUNNING)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_ABORTING);
+
+    // Arbitration-count definiert auf 0 setzen
+    psDatalog->sDatalogSerializer.ui8ArbitrationCount = 0;
+
+    if(psDatalog->sCallbacks.StopDataloggerCb != NULL)
+        psDatalog->sCallbacks.StopDataloggerCb();
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Starts recording the next segment with the next service tick.
+ ***********************************************************************************/
+static void _DataloggerStartSegment (tDATALOGGER *psDatalog)
+{
+    tDATALOG_CHANNEL *pChannel = psDatalog->sDatalogControl.sDatalogChannels;
+    tDATALOG_SEGMENT_TABLE *pTable = &psDatalog->sSequence.sTables[psDatalog->sDatalogControl.ui8CaptureBufIdx];
+
+    for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << i)))
+            continue;
+
+        pChannel[i].ui16DivideCount = 1;
+        pChannel[i].ui32SegmentEnd += pChannel[i].ui32SegmentLength;
+    }
+
+    pTable->sSegments[pTable->ui16Count].ui16SegmentIdx = psDatalog->sSequence.ui16CurSegment;
+    pTable->sSegments[pTable->ui16Count].ui32StartTick = psDatalog->sDatalogControl.ui32TickCount;
+    pTable->ui16Count++;
+
+    psDatalog->sSequence.ui8Armed = 0;
+    psDatalog->sSequence.ui8TriggerPending = 0;
+    psDatalog->sDatalogControl.ui8ChannelsRunning = psDatalog->sDatalogControl.ui8ActiveLoggers & ~psDatalog->sDatalogControl.ui8ChannelsStopped;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Called when all channels have recorded their segment. Rearms the next
+ * segment or stops the datalogger after the last one.
+ ***********************************************************************************/
+static void _DataloggerSegmentComplete (tDATALOGGER *psDatalog)
+{
+    if (++psDatalog->sSequence.ui16CurSegment >= psDatalog->sSequence.ui16SegmentCount)
+    {
+        DataloggerStop(psDatalog);
+        return;
+    }
+
+    if (psDatalog->sSequence.eRearmMode == eSEQMODE_TRIGGERED)
+    {
+        // Triggers that occured during the last segment are discarded
+        psDatalog->sSequence.ui8TriggerPending = 0;
+        psDatalog->sSequence.ui8Armed = 1;
+    }
+    else
+        _DataloggerStartSegment(psDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Publishes the recorded capture buffer for readout.
+ ***********************************************************************************/
+static void _DataloggerPublishCapture (tDATALOGGER *psDatalog)
+{
+    tDATALOG_SEGMENT_TABLE *pTable = &psDatalog->sSequence.sTables[psDatalog->sDatalogControl.ui8CaptureBufIdx];
+
+    // Write out the remaining bits of the bit channels
+    for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        tDATALOG_CHANNEL *pChannel = &psDatalog->sDatalogControl.sDatalogChannels[i];
+        uint32_t ui32WordPos = pChannel->ui32CurMemPos;
+
+        if ((psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << i)) && 
+            pChannel->ui8BitWidth &&
+            psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODERAM)
+            _DataloggerFlushBits(psDatalog->sDatalogControl.pui8Data, pChannel);
+
+#if DATALOGGER_CRC_BLOCK_SIZE
+        if (!(pTable->ui8CrcChannels & (1 << i)))
+            continue;
+
+        if (pChannel->ui32CurMemPos != ui32WordPos)
+            _DataloggerCrcAppend(pTable, pChannel, &psDatalog->sDatalogControl.pui8Data[ui32WordPos], 4);
+
+        // CRC of the incomplete last block
+        if (pChannel->ui32CrcPos % DATALOGGER_CRC_BLOCK_SIZE)
+            pTable->ui32BlockCrc[pChannel->ui16CrcFirstBlock + pChannel->ui32CrcPos / DATALOGGER_CRC_BLOCK_SIZE] = pChannel->ui32Crc;
+#else
+        (void)pTable;
+        (void)ui32WordPos;
+#endif
+    }
+
+    psDatalog->sDatalogControl.pui8ReadoutData = psDatalog->sDatalogControl.pui8Data;
+    psDatalog->sDatalogControl.ui8ReadoutBufIdx = psDatalog->sDatalogControl.ui8CaptureBufIdx;
+
+    for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
+        psDatalog->sDatalogControl.ui32ReadoutCount[i] = psDatalog->sDatalogControl.sDatalogChannels[i].ui32CurrentCount;
+
+    if (psDatalog->sDatalogControl.ui8RingWrapped)
+        _DataloggerRingUnroll(psDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Restarts ring channels which reached the end of their region.
+ ***********************************************************************************/
+static void _DataloggerRingWrap (tDATALOGGER *psDatalog, uint8_t ui8Channels)
+{
+    tDATALOG_CHANNEL *pChannel = psDatalog->sDatalogControl.sDatalogChannels;
+
+    for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        if (!(ui8Channels & (1 << i)))
+            continue;
+
+        pChannel[i].ui32CurMemPos = pChannel[i].ui32MemoryOffset;
+        pChannel[i].ui32CurrentCount = 0;
+        DATALOGGER_ATOMIC_STORE32(&pChannel[i].ui32CommittedCount, 0);
+    }
+
+    psDatalog->sDatalogControl.ui8RingWrapped |= ui8Channels;
+    DATALOGGER_ATOMIC_SET8(&psDatalog->sDatalogControl.ui8ChannelsRunning, ui8Channels);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Reverses ui32Len bytes in place.
+ ***********************************************************************************/
+static void _DataloggerReverse (uint8_t *pui8Data, uint32_t ui32Len)
+{
+    for (uint32_t i = 0, j = ui32Len; i + 1 < j; i++, j--)
+    {
+        uint8_t ui8Tmp = pui8Data[i];
+
+        pui8Data[i] = pui8Data[j - 1];
+        pui8Data[j - 1] = ui8Tmp;
+    }
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Rotates the wrapped ring channels of the published capture, so their 
+ * oldest sample comes first. The tick of the oldest sample is recorded as a rate
+ * marker with unchanged divider.
+ ***********************************************************************************/
+static void _DataloggerRingUnroll (tDATALOGGER *psDatalog)
+{
+    tDATALOG_CHANNEL *pChannel = psDatalog->sDatalogControl.sDatalogChannels;
+    tDATALOG_SEGMENT_TABLE *pTable = &psDatalog->sSequence.sTables[psDatalog->sDatalogControl.ui8ReadoutBufIdx];
+
+    for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        uint8_t *pui8Region = &psDatalog->sDatalogControl.pui8ReadoutData[pChannel[i].ui32MemoryOffset];
+        uint32_t ui32Len = pChannel[i].ui32SegmentLength * pChannel[i].ui8ByteCount;
+        uint32_t ui32Head = pChannel[i].ui32CurrentCount * pChannel[i].ui8ByteCount;
+        uint32_t ui32Ratio = _DataloggerTimebaseRatio(psDatalog, i);
+        uint32_t ui32LastTick;
+        tDATALOG_RATE_MARKER *pMarker;
+
+        if (!(psDatalog->sDatalogControl.ui8RingWrapped & psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << i)))
+            continue;
+
+        // Rotate left by the head: Reverse both parts, then the whole region
+        _DataloggerReverse(pui8Region, ui32Head);
+        _DataloggerReverse(pui8Region + ui32Head, ui32Len - ui32Head);
+        _DataloggerReverse(pui8Region, ui32Len);
+
+        psDatalog->sDatalogControl.ui32ReadoutCount[i] = pChannel[i].ui32SegmentLength;
+
+        // Last sample was taken (divider - divide count) ticks of the timebase ago
+        ui32LastTick = psDatalog->sDatalogControl.ui32TickCount - 1 - 
+                       (uint32_t)(pChannel[i].ui16Divider - pChannel[i].ui16DivideCount) * ui32Ratio;
+
+        pMarker = _DataloggerReserveMarker(pTable);
+
+        if (pMarker != NULL)
+        {
+            pMarker->ui8LogNum = i + 1;
+            pMarker->ui16OldDivider = pMarker->ui16Divider = pChannel[i].ui16Divider;
+            pMarker->ui32SampleIdx = 0;
+            pMarker->ui32Tick = ui32LastTick - (pChannel[i].ui32SegmentLength - 1) * pChannel[i].ui16Divider * ui32Ratio;
+        }
+    }
+
+    psDatalog->sDatalogControl.ui8RingWrapped = 0;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Memory size of a channel. Bit channels occupy whole 32 bit words.
+ ***********************************************************************************/
+static uint32_t _DataloggerChannelByteSize (tDATALOG_CHANNEL *pChannel)
+{
+    if (pChannel->ui8BitWidth)
+        return (uint32_t)((((uint64_t)pChannel->ui32RecordLength * pChannel->ui8BitWidth + 31) >> 5) << 2);
+
+    return pChannel->ui32RecordLength * pChannel->ui8ByteCount;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Memory size of a channel for a given record length.
+ ***********************************************************************************/
+static uint32_t _DataloggerPlannedByteSize (tDATALOG_CHANNEL *pChannel, uint32_t ui32RecLen)
+{
+    tDATALOG_CHANNEL sPlanned = *pChannel;
+
+    sPlanned.ui32RecordLength = ui32RecLen;
+
+    return _DataloggerChannelByteSize(&sPlanned);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Number of samples of a channel that fit into ui32Bytes.
+ ***********************************************************************************/
+static uint32_t _DataloggerMaxRecordLength (tDATALOG_CHANNEL *pChannel, uint32_t ui32Bytes)
+{
+    // Bit channels occupy whole 32 bit words
+    if (pChannel->ui8BitWidth)
+        return (uint32_t)(((uint64_t)(ui32Bytes & ~(uint32_t)3) << 3) / pChannel->ui8BitWidth);
+
+    return pChannel->ui8ByteCount ? ui32Bytes / pChannel->ui8ByteCount : 0;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Base ticks per tick of the timebase of a channel.
+ ***********************************************************************************/
+static uint16_t _DataloggerTimebaseRatio (tDATALOGGER *psDatalog, uint8_t ui8Idx)
+{
+    for (uint8_t k = 1; k < DATALOGGER_MAX_TIMEBASES; k++)
+    {
+        if (psDatalog->sTimebases.ui8Channels[k] & (1 << ui8Idx))
+            return psDatalog->sTimebases.ui16Ratio[k];
+    }
+
+    return 1;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Divider of a channel in base ticks.
+ ***********************************************************************************/
+static uint32_t _DataloggerTickDivider (tDATALOGGER *psDatalog, uint8_t ui8Idx)
+{
+    // Registered divider, the next start discards runtime changes
+    return (uint32_t)psDatalog->sMemoryHeader.sDatalogChannelsMemory[ui8Idx].ui16Divider * _DataloggerTimebaseRatio(psDatalog, ui8Idx);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Sets the parameters of a channel.
+ *
+ * The memory layout is only invalidated if the memory size of the channel 
+ * changes. Exchanging the variable of a channel keeps the logger initialized.
+ ***********************************************************************************/
+static tDATALOG_ERROR _DataloggerRegisterChannel (tDATALOGGER *psDatalog, uint32_t ui32ChID, uint8_t ui8LogNum, uint16_t ui16FreqDiv, uint32_t ui32RecLen, uint8_t *pui8Variable, uint8_t ui8ByteCount, uint32_t ui32BitMask)
+{
+    tDATALOG_CHANNEL        *pChannel; 
+    tDATALOG_CHANNEL_MEMORY *pMemChannel;
+    const tDATALOG_SCALING  sDefaultScaling = tDATALOG_SCALING_DEFAULTS;
+    uint32_t                ui32Mask = ui32BitMask;
+    uint32_t                ui32OldSize;
+    uint32_t                ui32OldRecLen;
+    uint8_t                 ui8Shift = 0;
+    bool                    bWasActive;
+    bool                    bSameSetup;
+
+    if (ui8LogNum == 0 || ui8LogNum > MAX_NUM_LOGS)
+        return eDATALOG_ERROR_NUMBER_OF_LOGS_EXCEEDED;
+
+    // Samples are read through a 64 bit value
+    if (ui8ByteCount == 0 || ui8ByteCount > 8)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    // Check if datalogger tasks are going on
+    switch(psDatalog->eDatalogState)
+    {
+        case eDLOGSTATE_RUNNING:
+        case eDLOGSTATE_FORMAT_MEMORY:
+        case eDLOGSTATE_ABORTING:
+            return eDATALOG_ERROR_WRONG_STATE;
+        
+        default:
+            break;
+    }
+    
+    pChannel = &psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1];
+    pMemChannel = &psDatalog->sMemoryHeader.sDatalogChannelsMemory[ui8LogNum - 1];
+    bWasActive = (psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << (ui8LogNum - 1))) != 0;
+    ui32OldSize = _DataloggerChannelByteSize(pChannel);
+    ui32OldRecLen = pChannel->ui32RecordLength;
+
+    // Everything reset below was already at its default, so a published capture
+    // is still decoded the same way
+    bSameSetup = pChannel->pfnGetter == NULL && !pChannel->ui8HistByteCount && !pChannel->ui8CicOrder && 
+                 pChannel->pui32Guard == NULL && (pChannel->ui32BitMask != 0) == (ui32BitMask != 0) &&
+                 (psDatalog->sTimebases.ui8Channels[0] & (1 << (ui8LogNum - 1))) &&
+                 pChannel->sScaling.eType == sDefaultScaling.eType && pChannel->sScaling.fGain == sDefaultScaling.fGain && 
+                 pChannel->sScaling.fOffset == sDefaultScaling.fOffset;
+
+    // Initialize parameter variables
+    pChannel->ui32ChID = pMemChannel->ui32ChannelID     = ui32ChID;
+    pChannel->pui8Variable = pMemChannel->pui8Variable  = pui8Variable;
+    pChannel->ui8ByteCount = pMemChannel->ui8ByteCount  = ui8ByteCount;
+    pChannel->ui16Divider = pMemChannel->ui16Divider    = ui16FreqDiv;
+    pChannel->ui32RecordLength                          = ui32RecLen;
+    pChannel->sScaling = pMemChannel->sScaling          = sDefaultScaling;
+    pChannel->ui32BitMask = pMemChannel->ui32BitMask    = ui32BitMask;
+    pChannel->ui8BitWidth                               = 0;
+    pChannel->pui32Guard                                = NULL;
+    pChannel->pfnGetter                                 = NULL;
+    pChannel->ui8HistByteCount                          = 0;
+    pChannel->ui8CicOrder                               = 0;
+    psDatalog->sDatalogControl.ui8GetterChannels &= ~(1 << (ui8LogNum - 1));
+
+    // Logs are registered on the base timebase
+    for (uint8_t k = 1; k < DATALOGGER_MAX_TIMEBASES; k++)
+        psDatalog->sTimebases.ui8Channels[k] &= ~(1 << (ui8LogNum - 1));
+
+    psDatalog->sTimebases.ui8Channels[0] |= (1 << (ui8LogNum - 1));
+
+    if (ui32BitMask)
+    {
+        while (!(ui32Mask & 1))
+        {
+            ui32Mask >>= 1;
+            ui8Shift++;
+        }
+
+        // Contiguous masks are extracted by shifting only
+        pChannel->ui8MaskShift = ((ui32Mask & (ui32Mask + 1)) == 0) ? ui8Shift : 0xFF;
+
+        for (ui32Mask = ui32BitMask; ui32Mask; ui32Mask &= ui32Mask - 1)
+            pChannel->ui8BitWidth++;
+    }
+
+    // Same memory footprint and setup: Offsets and buffers stay valid. A published 
+    // capture was recorded from the old variable (and divider), it is dropped.
+    if (bWasActive && bSameSetup && !_DataloggerReadoutAvailable(psDatalog) && ui32OldRecLen == ui32RecLen && 
+        ui32OldSize == _DataloggerChannelByteSize(pChannel))
+    {
+        // The gather descriptor still points to the old variable
+        if (psDatalog->sGather.ui8Channels & (1 << (ui8LogNum - 1)))
+        {
+            if (ui32BitMask)
+                DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_UNINITIALIZED);
+            else
+                psDatalog->sGather.sTable[ui8LogNum - 1].pui8Src = pui8Variable;
+        }
+
+        return eDATALOG_ERROR_NONE;
+    }
+
+    // Activate logger immediately
+    psDatalog->sDatalogControl.ui8ActiveLoggers |= (1 << (ui8LogNum - 1));
+    psDatalog->sDatalogControl.ui8LayoutDirty |= (1 << (ui8LogNum - 1));
+
+    // New value is set -> Need to initialize the datalogger prior to next log run.
+    DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_UNINITIALIZED);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Extracts the masked bits of a bit channel and appends them to the bit 
+ * stream. Complete 32 bit words are written in big endian format.
+ ***********************************************************************************/
+static void _DataloggerPackSample (uint8_t *pui8Data, tDATALOG_CHANNEL *pChannel)
+{
+    uint32_t ui32Raw = (uint32_t)_DataloggerReadVariable(pChannel);
+    uint32_t ui32Bits = 0;
+    uint32_t ui32Word;
+
+    if (pChannel->ui8MaskShift != 0xFF)
+        ui32Bits = (ui32Raw & pChannel->ui32BitMask) >> pChannel->ui8MaskShift;
+    else
+    {
+        // Scattered flags: Gather the mask bits, lowest mask bit becomes bit 0
+        uint8_t k = 0;
+
+        for (uint32_t ui32Mask = pChannel->ui32BitMask; ui32Mask; ui32Mask &= ui32Mask - 1, k++)
+        {
+            if (ui32Raw & ui32Mask & (~ui32Mask + 1))
+                ui32Bits |= (uint32_t)1 << k;
+        }
+    }
+
+    pChannel->ui64BitAcc = (pChannel->ui64BitAcc << pChannel->ui8BitWidth) | ui32Bits;
+    pChannel->ui8BitFill += pChannel->ui8BitWidth;
+
+    if (pChannel->ui8BitFill >= 32)
+    {
+        pChannel->ui8BitFill -= 32;
+        ui32Word = (uint32_t)(pChannel->ui64BitAcc >> pChannel->ui8BitFill);
+
+        pui8Data[pChannel->ui32CurMemPos]     = (uint8_t)(ui32Word >> 24);
+        pui8Data[pChannel->ui32CurMemPos + 1] = (uint8_t)(ui32Word >> 16);
+        pui8Data[pChannel->ui32CurMemPos + 2] = (uint8_t)(ui32Word >> 8);
+        pui8Data[pChannel->ui32CurMemPos + 3] = (uint8_t)ui32Word;
+        pChannel->ui32CurMemPos += 4;
+
+        // Samples completely contained in the written words
+        DATALOGGER_ATOMIC_STORE32(&pChannel->ui32CommittedCount, 
+                                  ((pChannel->ui32CurMemPos - pChannel->ui32MemoryOffset) << 3) / pChannel->ui8BitWidth);
+    }
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Reads a variable of ui8ByteCount bytes (little endian target).
+ *
+ * Aligned variables up to DATALOGGER_ATOMIC_LOAD_SIZE bytes are read with a 
+ * single load, so a concurrent write cannot tear the sample.
+ ***********************************************************************************/
+static inline uint64_t _DataloggerLoad (const uint8_t *pui8Variable, uint8_t ui8ByteCount)
+{
+    uint64_t ui64Val = 0;
+
+#if DATALOGGER_CONSISTENT_READ
+    if (ui8ByteCount <= DATALOGGER_ATOMIC_LOAD_SIZE && ((uintptr_t)pui8Variable & (ui8ByteCount - 1)) == 0)
+    {
+        switch (ui8ByteCount)
+        {
+            case 1: return *(const volatile uint8_t*)pui8Variable;
+            case 2: return *(const volatile uint16_t*)pui8Variable;
+            case 4: return *(const volatile uint32_t*)pui8Variable;
+            case 8: return *(const volatile uint64_t*)pui8Variable;
+            default: break;
+        }
+    }
+#endif
+
+    for (uint8_t j = ui8ByteCount; j > 0; j--)
+        ui64Val = (ui64Val << 8) | pui8Variable[j - 1];
+
+    return ui64Val;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Reads the variable of a channel, guarded variables by the sequence 
+ * counter protocol.
+ ***********************************************************************************/
+static inline uint64_t _DataloggerReadVariable (tDATALOG_CHANNEL *pChannel)
+{
+    // Fetched by _DataloggerCallGetters, computed by _DataloggerDecimate
+    if (pChannel->pfnGetter != NULL || pChannel->ui8CicOrder)
+        return pChannel->ui64LastValue;
+
+#if DATALOGGER_CONSISTENT_READ
+    if (pChannel->pui32Guard != NULL)
+    {
+        uint32_t ui32SeqBegin;
+        uint64_t ui64Val;
+
+        for (uint8_t r = 0; r < DATALOGGER_GUARD_RETRIES; r++)
+        {
+            ui32SeqBegin = *pChannel->pui32Guard;
+            DATALOGGER_MEMORY_BARRIER();
+
+            // Write in progress
+            if (ui32SeqBegin & 1)
+                continue;
+
+            ui64Val = _DataloggerLoad(pChannel->pui8Variable, pChannel->ui8ByteCount);
+            DATALOGGER_MEMORY_BARRIER();
+
+            if (*pChannel->pui32Guard == ui32SeqBegin)
+            {
+                pChannel->ui64LastValue = ui64Val;
+                return ui64Val;
+            }
+        }
+
+        return pChannel->ui64LastValue;
+    }
+#endif
+
+    return _DataloggerLoad(pChannel->pui8Variable, pChannel->ui8ByteCount);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Calls the getters of the channels sampled in this tick. Channels with 
+ * the same getter and context are fetched with one call.
+ ***********************************************************************************/
+static void _DataloggerCallGetters (tDATALOGGER *psDatalog, uint8_t ui8Channels)
+{
+    tDATALOG_CHANNEL *pChannel = psDatalog->sDatalogControl.sDatalogChannels;
+    uint64_t ui64Values[MAX_NUM_LOGS];
+    uint8_t ui8Due = 0;
+    uint8_t i, j;
+
+    for (i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        if ((psDatalog->sDatalogControl.ui8GetterChannels & ui8Channels & (1 << i)) &&
+            pChannel[i].ui16DivideCount == 1)
+            ui8Due |= (1 << i);
+    }
+
+    for (i = 0; ui8Due; i++)
+    {
+        uint8_t ui8Batch = 0;
+
+        if (!(ui8Due & (1 << i)))
+            continue;
+
+        for (j = i; j < MAX_NUM_LOGS; j++)
+        {
+            if ((ui8Due & (1 << j)) && pChannel[j].pfnGetter == pChannel[i].pfnGetter && 
+                pChannel[j].pvGetterCtx == pChannel[i].pvGetterCtx)
+                ui8Batch |= (1 << j);
+        }
+
+        pChannel[i].pfnGetter(ui8Batch, ui64Values, pChannel[i].pvGetterCtx);
+
+        for (j = i; j < MAX_NUM_LOGS; j++)
+        {
+            if (ui8Batch & (1 << j))
+                pChannel[j].ui64LastValue = ui64Values[j];
+        }
+
+        ui8Due &= ~ui8Batch;
+    }
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Writes the incomplete last word of a bit channel (zero padded).
+ ***********************************************************************************/
+static void _DataloggerFlushBits (uint8_t *pui8Data, tDATALOG_CHANNEL *pChannel)
+{
+    uint32_t ui32Word;
+
+    if (!pChannel->ui8BitFill)
+        return;
+
+    ui32Word = (uint32_t)(pChannel->ui64BitAcc << (32 - pChannel->ui8BitFill));
+
+    pui8Data[pChannel->ui32CurMemPos]     = (uint8_t)(ui32Word >> 24);
+    pui8Data[pChannel->ui32CurMemPos + 1] = (uint8_t)(ui32Word >> 16);
+    pui8Data[pChannel->ui32CurMemPos + 2] = (uint8_t)(ui32Word >> 8);
+    pui8Data[pChannel->ui32CurMemPos + 3] = (uint8_t)ui32Word;
+    pChannel->ui32CurMemPos += 4;
+    pChannel->ui8BitFill = 0;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Writes a variable of ui8ByteCount bytes (little endian target), the 
+ * counterpart of _DataloggerLoad.
+ ***********************************************************************************/
+static inline void _DataloggerStore (uint8_t *pui8Variable, uint8_t ui8ByteCount, uint64_t ui64Val)
+{
+#if DATALOGGER_CONSISTENT_READ
+    if (ui8ByteCount <= DATALOGGER_ATOMIC_LOAD_SIZE && ((uintptr_t)pui8Variable & (ui8ByteCount - 1)) == 0)
+    {
+        switch (ui8ByteCount)
+        {
+            case 1: *(volatile uint8_t*)pui8Variable = (uint8_t)ui64Val; return;
+            case 2: *(volatile uint16_t*)pui8Variable = (uint16_t)ui64Val; return;
+            case 4: *(volatile uint32_t*)pui8Variable = (uint32_t)ui64Val; return;
+            case 8: *(volatile uint64_t*)pui8Variable = ui64Val; return;
+            default: break;
+        }
+    }
+#endif
+
+    for (uint8_t j = 0; j < ui8ByteCount; j++, ui64Val >>= 8)
+        pui8Variable[j] = (uint8_t)ui64Val;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Writes the next recorded sample of a channel back into its variable.
+ *
+ * Bit channels only replace the bits selected by their mask.
+ ***********************************************************************************/
+static void _DataloggerReplaySample (uint8_t *pui8Data, tDATALOG_CHANNEL *pChannel)
+{
+    tDATALOG_CHANNEL_VIEW sView;
+    uint64_t ui64Val;
+
+    sView.pui8Base = &pui8Data[pChannel->ui32MemoryOffset];
+    sView.ui32Count = pChannel->ui32RecordLength;
+
+    if (pChannel->ui8BitWidth)
+    {
+        sView.ui16Stride = 0;
+        sView.ui8Width = (pChannel->ui8BitWidth + 7) >> 3;
+        sView.ui8BitWidth = pChannel->ui8BitWidth;
+        sView.eEncoding = eDATALOG_ENCODING_BITPACKED;
+    }
+    else
+    {
+        sView.ui16Stride = pChannel->ui8ByteCount;
+        sView.ui8Width = pChannel->ui8ByteCount;
+        sView.ui8BitWidth = pChannel->ui8ByteCount << 3;
+        sView.eEncoding = eDATALOG_ENCODING_BE;
+    }
+
+    ui64Val = DataloggerViewGetSample(&sView, pChannel->ui32CurrentCount);
+
+    if (pChannel->ui8BitWidth)
+    {
+        uint32_t ui32Raw = (uint32_t)_DataloggerLoad(pChannel->pui8Variable, pChannel->ui8ByteCount);
+        uint32_t ui32Bits = 0;
+
+        if (pChannel->ui8MaskShift != 0xFF)
+            ui32Bits = ((uint32_t)ui64Val << pChannel->ui8MaskShift) & pChannel->ui32BitMask;
+        else
+        {
+            // Scattered flags: Bit k goes to the k-th lowest mask bit
+            uint8_t k = 0;
+
+            for (uint32_t ui32Mask = pChannel->ui32BitMask; ui32Mask; ui32Mask &= ui32Mask - 1, k++)
+            {
+                if (ui64Val & ((uint64_t)1 << k))
+                    ui32Bits |= ui32Mask & (~ui32Mask + 1);
+            }
+        }
+
+        ui64Val = (ui32Raw & ~pChannel->ui32BitMask) | ui32Bits;
+    }
+
+    _DataloggerStore(pChannel->pui8Variable, pChannel->ui8ByteCount, ui64Val);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Counts the value of a histogram channel in its bin.
+ ***********************************************************************************/
+static void _DataloggerHistogramSample (uint8_t *pui8Data, tDATALOG_CHANNEL *pChannel)
+{
+    uint64_t ui64Raw = _DataloggerLoad(pChannel->pui8Variable, pChannel->ui8HistByteCount);
+    uint64_t ui64Bin;
+    uint8_t *pui8Bin;
+    uint32_t ui32Count;
+    int64_t i64Val;
+
+    // Sign extension from the variable width
+    if (pChannel->ui8HistSigned)
+    {
+        uint64_t ui64Sign = (uint64_t)1 << ((pChannel->ui8HistByteCount << 3) - 1);
+
+        i64Val = (int64_t)((ui64Raw ^ ui64Sign) - ui64Sign);
+    }
+    else
+        i64Val = (int64_t)ui64Raw;
+
+    i64Val -= pChannel->i32HistMin;
+
+    // Out of range values are counted in the outer bins
+    if (i64Val < 0)
+        ui64Bin = 0;
+    else
+    {
+        ui64Bin = (uint64_t)i64Val >> pChannel->ui8HistShift;
+
+        if (ui64Bin >= pChannel->ui32RecordLength)
+            ui64Bin = pChannel->ui32RecordLength - 1;
+    }
+
+    pui8Bin = &pui8Data[pChannel->ui32MemoryOffset + ((uint32_t)ui64Bin << 2)];
+    ui32Count = ((uint32_t)pui8Bin[0] << 24) | ((uint32_t)pui8Bin[1] << 16) | ((uint32_t)pui8Bin[2] << 8) | pui8Bin[3];
+
+    if (ui32Count == 0xFFFFFFFF)
+        return;
+
+    ui32Count++;
+    pui8Bin[0] = (uint8_t)(ui32Count >> 24);
+    pui8Bin[1] = (uint8_t)(ui32Count >> 16);
+    pui8Bin[2] = (uint8_t)(ui32Count >> 8);
+    pui8Bin[3] = (uint8_t)ui32Count;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Gain divider^order of a CIC decimator.
+ ***********************************************************************************/
+static inline uint64_t _DataloggerCicGain (uint8_t ui8Order, uint16_t ui16Divider)
+{
+    uint64_t ui64Gain = 1;
+
+    for (uint8_t k = 0; k < ui8Order; k++)
+        ui64Gain *= ui16Divider;
+
+    return ui64Gain;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Checks that the filter output of full scale input fits the 64 bit state.
+ ***********************************************************************************/
+static bool _DataloggerCicInRange (uint8_t ui8Order, uint16_t ui16Divider, uint8_t ui8ByteCount)
+{
+    return _DataloggerCicGain(ui8Order, ui16Divider) < ((uint64_t)1 << (63 - (ui8ByteCount << 3)));
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Runs the CIC decimator of a channel for one input tick. In the tick of
+ * the next sample, the comb stages produce the output (ui64LastValue).
+ *
+ * The state wraps modulo 2^64, which is exact as long as the output fits.
+ ***********************************************************************************/
+static inline void _DataloggerDecimate (tDATALOG_CHANNEL *pChannel)
+{
+    uint64_t ui64In = _DataloggerLoad(pChannel->pui8Variable, pChannel->ui8ByteCount);
+    uint64_t ui64Out;
+    int64_t i64Out;
+    uint8_t k;
+
+    if (pChannel->sScaling.eType == eDATALOG_TYPE_INT)
+    {
+        uint64_t ui64Sign = (uint64_t)1 << ((pChannel->ui8ByteCount << 3) - 1);
+
+        ui64In = (ui64In ^ ui64Sign) - ui64Sign;
+    }
+
+    pChannel->ui64CicInteg[0] += ui64In;
+
+    for (k = 1; k < pChannel->ui8CicOrder; k++)
+        pChannel->ui64CicInteg[k] += pChannel->ui64CicInteg[k - 1];
+
+    if (pChannel->ui16DivideCount != 1)
+        return;
+
+    ui64Out = pChannel->ui64CicInteg[pChannel->ui8CicOrder - 1];
+
+    for (k = 0; k < pChannel->ui8CicOrder; k++)
+    {
+        uint64_t ui64Delay = pChannel->ui64CicComb[k];
+
+        pChannel->ui64CicComb[k] = ui64Out;
+        ui64Out -= ui64Delay;
+    }
+
+    // Output of the settling filter would be attenuated
+    if (pChannel->ui8CicWarmup)
+    {
+        pChannel->ui8CicWarmup--;
+        pChannel->ui64LastValue = ui64In;
+        return;
+    }
+
+    i64Out = (int64_t)ui64Out / (int64_t)_DataloggerCicGain(pChannel->ui8CicOrder, pChannel->ui16Divider);
+    pChannel->ui64LastValue = (uint64_t)i64Out;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Continues the block CRC of a channel with the bytes just written and
+ * stores the CRC of every completed block.
+ ***********************************************************************************/
+void _DataloggerCrcAppend (tDATALOG_SEGMENT_TABLE *pTable, tDATALOG_CHANNEL *pChannel, const uint8_t *pui8Data, uint32_t ui32Len)
+{
+#if DATALOGGER_CRC_BLOCK_SIZE
+    while (ui32Len)
+    {
+        uint32_t ui32Chunk = DATALOGGER_CRC_BLOCK_SIZE - pChannel->ui32CrcPos % DATALOGGER_CRC_BLOCK_SIZE;
+
+        if (ui32Chunk > ui32Len)
+            ui32Chunk = ui32Len;
+
+        pChannel->ui32Crc = DataloggerCrc32Update(pChannel->ui32Crc, pui8Data, ui32Chunk);
+        pChannel->ui32CrcPos += ui32Chunk;
+        pui8Data += ui32Chunk;
+        ui32Len -= ui32Chunk;
+
+        if (pChannel->ui32CrcPos % DATALOGGER_CRC_BLOCK_SIZE == 0)
+        {
+            pTable->ui32BlockCrc[pChannel->ui16CrcFirstBlock + pChannel->ui32CrcPos / DATALOGGER_CRC_BLOCK_SIZE - 1] = pChannel->ui32Crc;
+            pChannel->ui32Crc = DATALOGGER_CRC32_INIT;
+        }
+    }
+#else
+    (void)pTable;
+    (void)pChannel;
+    (void)pui8Data;
+    (void)ui32Len;
+#endif
+}
+
+//===================================================================================
+// Function: DataloggerReplayLoad
+//===================================================================================
+/********************************************************************************//**
+ * \brief Loads recorded data of a channel for replay.
+ *
+ * The data has the layout of the channel view of a RAM capture (big endian 
+ * samples, MSB first bit stream for bit channels) and is copied to the channel's
+ * region of the capture buffer. Requires an initialized replay datalogger.
+ *
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerReplayLoad (tDATALOGGER *psDatalog, uint8_t ui8LogNum, const uint8_t *pui8Data, uint32_t ui32Len)
+{
+    tDATALOG_CHANNEL *pChannel;
+
+    if (ui8LogNum == 0 || ui8LogNum > MAX_NUM_LOGS)
+        return eDATALOG_ERROR_NUMBER_OF_LOGS_EXCEEDED;
+
+    if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << (ui8LogNum - 1))))
+        return eDATALOG_ERROR_CHANNEL_NOT_ACTIVE;
+
+    if (psDatalog->sDatalogControl.eOpMode != eOPMODE_REPLAY)
+        return eDATALOG_ERROR_WRONG_OPMODE;
 
-            ui32CurrentByteSize +=  psDatalog->sDatalogControl.sDatalogChannels[i].ui32RecordLength *
-                                    psDatalog->sDatalogControl.sDatalogChannels[i].ui8ByteCount;
-        }
-        ui8LogCount++;
-    }
+    if (psDatalog->eDatalogState != eDLOGSTATE_INITIALIZED && psDatalog->eDatalogState != eDLOGSTATE_DATA_READY)
+        return eDATALOG_ERROR_WRONG_STATE;
 
+    pChannel = &psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1];
 
-    /********************************************************************************
-     * RAM initialization routines
-     *******************************************************************************/
-    if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODEMEM)
-    {
-        // temporary buffer is always set to max size
-        ui16TempSize = DATALOGGER_MAX_BUFFER_SIZE / (ui8LogCount << 1);
+    if (ui32Len > _DataloggerChannelByteSize(pChannel))
+        return eDATALOG_ERROR_INVALID_PARAMETER;
 
-        for(i = 0; i < ui8LogCount; i++)
-        {
-            pChannel = &psDatalog->sDatalogControl.sDatalogChannels[ui8LogIdx[i]];
+    memcpy(&psDatalog->sDatalogControl.pui8Data[pChannel->ui32MemoryOffset], pui8Data, ui32Len);
 
-            pChannel->ui8RamBuf[0] = (uint8_t*)malloc((size_t)(ui16TempSize));
-            pChannel->ui8RamBuf[1] = (uint8_t*)malloc((size_t)(ui16TempSize));
+    return eDATALOG_ERROR_NONE;
+}
 
-            // Retrieve data whenn the index exceeds half of the memory size
-            pChannel->ui16RetrieveThreshIdx = ui16TempSize >> 2;
+//===================================================================================
+// Function: DataloggerReplayAdvance
+//===================================================================================
+/********************************************************************************//**
+ * \brief Runs up to ui32Ticks service ticks of a replay at once.
+ *
+ * Ticks in which no channel is due are skipped without touching the channels, so 
+ * sparse replays (large dividers) run much faster than tick by tick. Stops early
+ * when the replay ends. Covers timebase 0, channels of other timebases are 
+ * replayed by DataloggerServiceTimebase.
+ *
+ * @returns Error indicator
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerReplayAdvance (tDATALOGGER *psDatalog, uint32_t ui32Ticks, uint32_t *pui32Done)
+{
+    tDATALOG_CHANNEL *pChannel = psDatalog->sDatalogControl.sDatalogChannels;
+    uint8_t ui8Channels;
+    uint32_t ui32Done = 0;
 
-            // Flag that the memory of this channel has been acquired
-            psDatalog->sDatalogControl.ui8MemoryAcquired |= (1 << ui8LogIdx[i]);
-            
-        }
-        // Note: pChannel still pointing on the last active memory channel
-        psDatalog->sMemoryHeader.ui32LastAddress = 
-            psDatalog->sMemoryHeader.sDatalogChannelsMemory[ui8LogIdx[ui8LogCount - 1]].ui32MemoryOffset + 
-            pChannel->ui32RecordLength - 1;
+    if (psDatalog->sDatalogControl.eOpMode != eOPMODE_REPLAY)
+        return eDATALOG_ERROR_WRONG_OPMODE;
 
-        psDatalog->sMemoryHeader.ui32TimeBase = psDatalog->sNVPar.ui32EE_TimeBase_Hz;
-    }
-    else if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODERAM)
+    while (ui32Done < ui32Ticks && psDatalog->eDatalogState == eDLOGSTATE_RUNNING)
     {
-        if (ui32CurrentByteSize > DATALOGGER_MAX_BUFFER_SIZE)
-            return eDATALOG_ERROR_NOT_ENOUGH_MEMORY;
-        
-        psDatalog->sDatalogControl.pui8Data = (uint8_t*)calloc((size_t)ui32CurrentByteSize, 1);
-        psDatalog->sDatalogControl.ui8MemoryAcquired = 1;
+        ui8Channels = psDatalog->sDatalogControl.ui8ChannelsRunning & psDatalog->sTimebases.ui8Channels[0];
 
-        if (psDatalog->sDatalogControl.pui8Data == NULL)
-            return eDATALOG_ERROR_MEMORY_ALLOCATION_FAILED;
-    }
+        // Idle ticks up to the next due channel
+        if (!psDatalog->sSequence.ui8Armed && ui8Channels)
+        {
+            uint32_t ui32Skip = ui32Ticks - ui32Done - 1;
 
-    psDatalog->sDatalogControl.ui32MemLen = ui32CurrentByteSize;
-    /********************************************************************************
-     * State control
-     *******************************************************************************/
-    
-    //TODO: LIVEMODE Ringbuffer initialization
+            for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
+            {
+                if ((ui8Channels & (1 << i)) && (uint32_t)(pChannel[i].ui16DivideCount - 1) < ui32Skip)
+                    ui32Skip = pChannel[i].ui16DivideCount - 1;
+            }
 
-    if (psDatalog->sDatalogControl.eOpMode != eOPMODE_RECMODEMEM)
-    {
-        DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_INITIALIZED);
-        // psDatalog->eDatalogStatePending = eDLOGSTATE_INITIALIZED;
-    }
-    else 
-    {
-        DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_FORMAT_MEMORY);
-        // psDatalog->eDatalogStatePending = eDLOGSTATE_FORMAT_MEMORY;
+            for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
+            {
+                if (ui8Channels & (1 << i))
+                    pChannel[i].ui16DivideCount -= (uint16_t)ui32Skip;
+            }
+
+            psDatalog->sDatalogControl.ui32TickCount += ui32Skip;
+            ui32Done += ui32Skip;
+        }
+
+        DataloggerService(psDatalog);
+        ui32Done++;
     }
 
+    if (pui32Done != NULL)
+        *pui32Done = ui32Done;
+
     return eDATALOG_ERROR_NONE;
 }
 
 //===================================================================================
-// Funktion: DatalogInitializeRead
-//===================================================================================
-// Parameter: keine
-//-----------------------------------------------------------------------------------
-// R�ckgabewerte:   true: Initialisierung erfolgreich.
-//                  false: Fehler.
-//-----------------------------------------------------------------------------------
-// Beschreibung: Initialisiert und startet das Auslesen des Datalog-Memorys
-//===================================================================================
-/* bool InitializeMemoryRead (void) */
-/* { */
-/*     // Raus bei falschem Zustand */
-/*     if (sDatalog.eDatalog_state != eINT_MODE_UNINITIALIZED       && */
-/*         sDatalog.eDatalog_state != eINT_MODE_INITIALIZED         && */
-/*         sDatalog.eDatalog_state != eINT_MODE_READY_TO_START) */
-/*     { */
-/*         return false; */
-/*     } */
+/********************************************************************************//**
+ * \brief Checks and queues a divider change (0: stop) of a running channel.
+ ***********************************************************************************/
+static tDATALOG_ERROR _DataloggerRequestRateChange (tDATALOGGER *psDatalog, uint8_t ui8LogNum, uint16_t ui16Divider)
+{
+    tDATALOG_SEGMENT_TABLE *pTable = &psDatalog->sSequence.sTables[psDatalog->sDatalogControl.ui8CaptureBufIdx];
+    uint16_t ui16Markers = pTable->ui16MarkerCount;
 
-/*     // G�ltigkeitscheck der zu lesenden Adressen */
-/*     if (sDatalog.sMemory_read.ui32Memory_offset >= FRAM_MAX_ADDRESS || */
-/*         sDatalog.sMemory_read.ui32Last_address > FRAM_MAX_ADDRESS) */
-/*     { */
-/*         return false; */
-/*     } */
+    if (ui8LogNum == 0 || ui8LogNum > MAX_NUM_LOGS)
+        return eDATALOG_ERROR_LOG_NUMBER_INVALID;
 
-/*     // Data IN Endpoint aktivieren */
-/*     sRoboard_interface.sData_in_endpoint.bEndpoint_active = true; */
-/*     // Abspeichern des alten Datenloggerzustandes f�r den Restore */
-/*     sDatalog.eDatalog_old_state = sDatalog.eDatalog_state; */
-/*     // Zustand umschalten */
-/*     sDatalog.eDatalog_state = eMEMORY_READ; */
+    if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & ~psDatalog->sDatalogControl.ui8ChannelsStopped & (1 << (ui8LogNum - 1))))
+        return eDATALOG_ERROR_CHANNEL_NOT_ACTIVE;
 
-/*     return true; */
-/* } */
+    if (psDatalog->eDatalogState != eDLOGSTATE_RUNNING)
+        return eDATALOG_ERROR_WRONG_STATE;
 
+    // Ring captures use the markers for the tick of their oldest sample
+    if (psDatalog->sSequence.eRearmMode == eSEQMODE_RING)
+        return eDATALOG_ERROR_NOT_IMPLEMENTED;
+
+    // The filter gain grows with the divider
+    if (ui16Divider && psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1].ui8CicOrder &&
+        !_DataloggerCicInRange(psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1].ui8CicOrder, ui16Divider,
+                               psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1].ui8ByteCount))
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    // Every pending change gets a marker
+    for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
+        ui16Markers += (psDatalog->sDatalogControl.ui8RateChanges >> i) & 1;
+
+    if (ui16Markers >= DATALOGGER_MAX_MARKERS)
+        return eDATALOG_ERROR_NOT_ENOUGH_MEMORY;
+
+    psDatalog->sDatalogControl.sDatalogChannels[ui8LogNum - 1].ui16PendingDivider = ui16Divider;
+    DATALOGGER_ATOMIC_SET8(&psDatalog->sDatalogControl.ui8RateChanges, 1 << (ui8LogNum - 1));
+
+    return eDATALOG_ERROR_NONE;
+}
 
-//===================================================================================
-// Function: DatalogStart
 //===================================================================================
 /********************************************************************************//**
- * \brief Starts the datalogger
- *
- * @returns Error indicator
+ * \brief Applies the pending rate changes of the running channels of ui8Channels
+ * at the tick boundary and records their markers.
  ***********************************************************************************/
-tDATALOG_ERROR DataloggerStart (tDATALOGGER *psDatalog)
+static void _DataloggerApplyRateChanges (tDATALOGGER *psDatalog, uint8_t ui8Channels)
 {
-    uint8_t i = 0;
-    tDATALOG_CHANNEL* pChannel = psDatalog->sDatalogControl.sDatalogChannels;
+    tDATALOG_SEGMENT_TABLE *pTable = &psDatalog->sSequence.sTables[psDatalog->sDatalogControl.ui8CaptureBufIdx];
+    tDATALOG_CHANNEL *pChannel = psDatalog->sDatalogControl.sDatalogChannels;
+    tDATALOG_RATE_MARKER sMarker;
+    tDATALOG_RATE_MARKER *pMarker;
 
-    if (psDatalog->eDatalogState != eDLOGSTATE_INITIALIZED)
-        return eDATALOG_ERROR_WRONG_STATE;
+    ui8Channels &= psDatalog->sDatalogControl.ui8RateChanges & psDatalog->sDatalogControl.ui8ChannelsRunning;
 
-    // Resets all relevant variables
-    while (i < MAX_NUM_LOGS)
+    if (!ui8Channels)
+        return;
+
+    for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
     {
-        if (!(psDatalog->sDatalogControl.ui8ActiveLoggers & (1 << i)))
-        {
-            i++;
+        if (!(ui8Channels & (1 << i)))
             continue;
-        }
 
-        // Reset of the state variables
-        pChannel[i].ui8BufNum = 0;
-        pChannel[i].ui16DivideCount = 1;
-        pChannel[i].ui16ValIdx = 0;
-        pChannel[i].ui32CurrentCount = 0;
-        
-        if(psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODERAM)
+        DATALOGGER_ATOMIC_CLEAR8(&psDatalog->sDatalogControl.ui8RateChanges, 1 << i);
+
+        sMarker.ui8LogNum = i + 1;
+        sMarker.ui16OldDivider = pChannel[i].ui16Divider;
+        sMarker.ui16Divider = pChannel[i].ui16PendingDivider;
+        sMarker.ui32SampleIdx = pChannel[i].ui32CurrentCount;
+
+        if (sMarker.ui16Divider == 0)
         {
-            pChannel[i].ui32CurMemPos = psDatalog->sDatalogControl.sDatalogChannels[i].ui32MemoryOffset;
-            // psDatalog->sDatalogControl.ui32CurIdx = 0;
+            DATALOGGER_ATOMIC_SET8(&psDatalog->sDatalogControl.ui8ChannelsStopped, 1 << i);
+            DATALOGGER_ATOMIC_CLEAR8(&psDatalog->sDatalogControl.ui8ChannelsRunning, 1 << i);
+            sMarker.ui32Tick = psDatalog->sDatalogControl.ui32TickCount;
         }
-        else if(psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODEMEM)
+        else
         {
-            pChannel[i].ui32CurMemPos = psDatalog->sMemoryHeader.sDatalogChannelsMemory[i].ui32MemoryOffset;
-
-            // Reset the control variables of the serializer
-            psDatalog->sDatalogSerializer.ui8ArbitrationCount = 0;
-            psDatalog->sDatalogSerializer.ui8FillIdx = 0;
-            psDatalog->sDatalogSerializer.ui8RetrieveFlags = 0;
-            psDatalog->sDatalogSerializer.ui8RetrieveIdx = 0;
-        }
+            // The next sample follows after at most the new divider
+            if (pChannel[i].ui16DivideCount > sMarker.ui16Divider)
+                pChannel[i].ui16DivideCount = sMarker.ui16Divider;
 
-        i++;
-    }
+            pChannel[i].ui16Divider = sMarker.ui16Divider;
 
-    psDatalog->sDatalogControl.ui8ChannelsRunning = 
-        psDatalog->sDatalogControl.ui8ActiveLoggers;
+            // The filter history holds a window of the old divider, the gain changes
+            if (pChannel[i].ui8CicOrder)
+            {
+                pChannel[i].ui8CicWarmup = pChannel[i].ui8CicOrder;
+                memset(pChannel[i].ui64CicInteg, 0, sizeof(pChannel[i].ui64CicInteg));
+                memset(pChannel[i].ui64CicComb, 0, sizeof(pChannel[i].ui64CicComb));
+            }
 
-    // Switch the datalog on (directly, because this is time critical)
-    DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_RUNNING);
+            sMarker.ui32Tick = psDatalog->sDatalogControl.ui32TickCount + 
+                               (uint32_t)(pChannel[i].ui16DivideCount - 1) * _DataloggerTimebaseRatio(psDatalog, i);
+        }
 
-    if(psDatalog->sCallbacks.StartDataloggerCb != NULL)
-        psDatalog->sCallbacks.StartDataloggerCb();
+        pMarker = _DataloggerReserveMarker(pTable);
 
-    return eDATALOG_ERROR_NONE;
+        if (pMarker != NULL)
+            *pMarker = sMarker;
+    }
 }
 
-//===================================================================================
-// Function: DataloggerStop
 //===================================================================================
 /********************************************************************************//**
- * \brief Stops the datalogger
+ * \brief Reserves the next marker of a capture.
  *
- * @returns Error indicator
+ * Services of different timebases may preempt each other while appending.
+ *
+ * @returns Reserved marker, NULL if the table is full.
  ***********************************************************************************/
-tDATALOG_STATE DataloggerStop (tDATALOGGER *psDatalog)
+static tDATALOG_RATE_MARKER* _DataloggerReserveMarker (tDATALOG_SEGMENT_TABLE *pTable)
 {
-    if (psDatalog->eDatalogState != eDLOGSTATE_RUNNING)
-        return eDATALOG_ERROR_WRONG_STATE;
+    uint16_t ui16Idx;
 
-    DataloggerSetStateImmediate(psDatalog, eDLOGSTATE_ABORTING);
+#if defined(DATALOGGER_CRITICAL_ENTER)
+    DATALOGGER_CRITICAL_ENTER();
+    ui16Idx = pTable->ui16MarkerCount;
 
-    // Arbitration-count definiert auf 0 setzen
-    psDatalog->sDatalogSerializer.ui8ArbitrationCount = 0;
+    if (ui16Idx < DATALOGGER_MAX_MARKERS)
+        pTable->ui16MarkerCount = ui16Idx + 1;
 
-    if(psDatalog->sCallbacks.StopDataloggerCb != NULL)
-        psDatalog->sCallbacks.StopDataloggerCb();
+    DATALOGGER_CRITICAL_EXIT();
+#elif defined(__GNUC__)
+    ui16Idx = __atomic_load_n(&pTable->ui16MarkerCount, __ATOMIC_RELAXED);
 
-    return eDATALOG_ERROR_NONE;
+    do
+    {
+        if (ui16Idx >= DATALOGGER_MAX_MARKERS)
+            break;
+    } while (!__atomic_compare_exchange_n(&pTable->ui16MarkerCount, &ui16Idx, ui16Idx + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+#else
+#error DATALOGGER_CRITICAL_ENTER/EXIT have to be defined for this compiler
+#endif
+
+    return (ui16Idx < DATALOGGER_MAX_MARKERS) ? &pTable->sMarkers[ui16Idx] : NULL;
 }
 
+//===================================================================================
 /********************************************************************************//**
- * \brief Samples the previously selected values
+ * \brief Samples the due channels of ui8Channels.
  *
- * This routine must get called regularly with a defined time base.
+ * @returns true if a memory buffer overflow requires to abort the run.
  ***********************************************************************************/
-void DataloggerService (tDATALOGGER *psDatalog)
+static bool _DataloggerSampleChannels (tDATALOGGER *psDatalog, uint8_t ui8Channels)
 {
     uint8_t i;
     bool bAbort_flag = false;
     // bool tmp;
     tDATALOG_CHANNEL *pChannel = psDatalog->sDatalogControl.sDatalogChannels;
-    uint8_t ui8ChannelsRunningTemp = psDatalog->sDatalogControl.ui8ChannelsRunning;
+    uint8_t ui8ChannelsRunningTemp;
+    uint8_t ui8GatherCount = 0;
+#if DATALOGGER_CRC_BLOCK_SIZE
+    tDATALOG_SEGMENT_TABLE *pTable = &psDatalog->sSequence.sTables[psDatalog->sDatalogControl.ui8CaptureBufIdx];
+#endif
     // uint32_t ui32CurrentOffset = 0;
 
-    if (psDatalog->eDatalogState != eDLOGSTATE_RUNNING)
-        return;
+    ui8ChannelsRunningTemp = psDatalog->sDatalogControl.ui8ChannelsRunning & ui8Channels;
+
+    // Fetch the values of the due getter channels
+    if (psDatalog->sDatalogControl.ui8GetterChannels & ui8ChannelsRunningTemp)
+        _DataloggerCallGetters(psDatalog, ui8ChannelsRunningTemp);
 
     // Get all data
     for (i = 0; i < MAX_NUM_LOGS; i++)
@@ -526,30 +2676,81 @@ void DataloggerService (tDATALOGGER *psDatalog)
             break;
 
         // Check if Channel is activated and running
-        if (!(psDatalog->sDatalogControl.ui8ChannelsRunning & (1 << i)))
+        if (!(ui8ChannelsRunningTemp & (1 << i)))
             continue;
 
         ui8ChannelsRunningTemp &= ~ (1 << i);
 
+        // Decimation filters see every tick
+        if (pChannel[i].ui8CicOrder)
+            _DataloggerDecimate(&pChannel[i]);
+
         // Sample data
         if (!(--pChannel[i].ui16DivideCount))
         {
-            if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODERAM) 
+            // Histograms count until the run is stopped
+            if (pChannel[i].ui8HistByteCount)
+            {
+                _DataloggerHistogramSample(psDatalog->sDatalogControl.pui8Data, &pChannel[i]);
+                pChannel[i].ui16DivideCount = pChannel[i].ui16Divider;
+                continue;
+            }
+
+            if (psDatalog->sGather.ui8Channels & (1 << i))
+            {
+                // Append the channel to the gather list of this tick
+                tDATALOG_GATHER_DESC *pDesc = &psDatalog->sGather.sDue[ui8GatherCount++];
+
+                *pDesc = psDatalog->sGather.sTable[i];
+                pDesc->pui8Dst = &psDatalog->sDatalogControl.pui8Data[pChannel[i].ui32CurMemPos];
+                pChannel[i].ui32CurMemPos += pChannel[i].ui8ByteCount;
+            }
+            else if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODERAM && pChannel[i].ui8BitWidth)
+            {
+#if DATALOGGER_CRC_BLOCK_SIZE
+                uint32_t ui32WordPos = pChannel[i].ui32CurMemPos;
+
+                _DataloggerPackSample(psDatalog->sDatalogControl.pui8Data, &pChannel[i]);
+
+                // A complete word has been written
+                if (pChannel[i].ui32CurMemPos != ui32WordPos && (pTable->ui8CrcChannels & (1 << i)))
+                    _DataloggerCrcAppend(pTable, &pChannel[i], &psDatalog->sDatalogControl.pui8Data[ui32WordPos], 4);
+#else
+                _DataloggerPackSample(psDatalog->sDatalogControl.pui8Data, &pChannel[i]);
+#endif
+            }
+            else if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODERAM) 
             {
+                uint8_t *pui8Dst = &psDatalog->sDatalogControl.pui8Data[pChannel[i].ui32CurMemPos];
+                uint64_t ui64Val = _DataloggerReadVariable(&pChannel[i]);
+
                 // Fill buffer in big endian format
-                for(uint8_t j = 0; j < pChannel[i].ui8ByteCount; j++)
-                {
-                    psDatalog->sDatalogControl.pui8Data[pChannel[i].ui32MemoryOffset + (pChannel[i].ui32CurrentCount << (pChannel[i].ui8ByteCount >> 1)) + j] = 
-                        pChannel[i].pui8Variable[pChannel[i].ui8ByteCount - 1 - j];
-                }
+                for(uint8_t j = pChannel[i].ui8ByteCount; j > 0; j--, ui64Val >>= 8)
+                    pui8Dst[j - 1] = (uint8_t)ui64Val;
+
+                pChannel[i].ui32CurMemPos += pChannel[i].ui8ByteCount;
+
+#if DATALOGGER_CRC_BLOCK_SIZE
+                if (pTable->ui8CrcChannels & (1 << i))
+                    _DataloggerCrcAppend(pTable, &pChannel[i], pui8Dst, pChannel[i].ui8ByteCount);
+#endif
+
+                // Publish the sample (counted below)
+                DATALOGGER_ATOMIC_STORE32(&pChannel[i].ui32CommittedCount, pChannel[i].ui32CurrentCount + 1);
+            }
+            else if (psDatalog->sDatalogControl.eOpMode == eOPMODE_REPLAY)
+            {
+                _DataloggerReplaySample(psDatalog->sDatalogControl.pui8Data, &pChannel[i]);
             }
             else if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODEMEM)
             {
+                uint64_t ui64Val = _DataloggerReadVariable(&pChannel[i]);
+
                 // Fill the appropirate arbitration buffer with data in big endian format
-                for(uint8_t j = 0; j < pChannel[i].ui8ByteCount; j++)
+                for(uint8_t j = pChannel[i].ui8ByteCount; j > 0; j--, ui64Val >>= 8)
                 {
-                    pChannel[i].ui8RamBuf[pChannel[i].ui8BufNum][(pChannel[i].ui32CurrentCount << (pChannel[i].ui8ByteCount >> 1)) + j] = 
-                        pChannel[i].pui8Variable[pChannel[i].ui8ByteCount - 1 - j];
+                    pChannel[i].ui8RamBuf[pChannel[i].ui8BufNum][pChannel[i].ui32CurrentCount * pChannel[i].ui8ByteCount + j - 1] = 
+                        (uint8_t)ui64Val;
                 }
 
                 // Set flag to empty the currently used buffer
@@ -561,21 +2762,112 @@ void DataloggerService (tDATALOGGER *psDatalog)
                     bAbort_flag = true;
             }
 
-            // Switch off channel if it has reached its maximum count
-            if (++pChannel[i].ui32CurrentCount == pChannel[i].ui32RecordLength)
-                psDatalog->sDatalogControl.ui8ChannelsRunning &= ~(1 << i);
-
             pChannel[i].ui16DivideCount = pChannel[i].ui16Divider;
+
+            // Switch off channel if it has reached the end of its segment. Last 
+            // access to the channel, the next segment may be started right after.
+            if (++pChannel[i].ui32CurrentCount == pChannel[i].ui32SegmentEnd)
+                DATALOGGER_ATOMIC_CLEAR8(&psDatalog->sDatalogControl.ui8ChannelsRunning, 1 << i);
         }
     }
 
-    bAbort_flag = (psDatalog->sDatalogControl.ui8ActiveLoggers & psDatalog->sDatalogControl.ui8ChannelsRunning) == 0;
-    // If all channels reached their record length, switch off datalogger
+    // Kick off the transfer of the due channels
+    if (ui8GatherCount)
+        psDatalog->sGather.pfnGather(psDatalog->sGather.sDue, ui8GatherCount, psDatalog->sGather.pvCtx);
+
+    return bAbort_flag;
+}
+
+/********************************************************************************//**
+ * \brief Samples the previously selected values
+ *
+ * This routine must get called regularly with a defined time base.
+ ***********************************************************************************/
+void DataloggerService (tDATALOGGER *psDatalog)
+{
+    if (!_DataloggerServiceBegin(psDatalog))
+        return;
+
+    // A memory buffer overflow aborts the run
+    if (_DataloggerSampleChannels(psDatalog, psDatalog->sTimebases.ui8Channels[0]))
+    {
+        DataloggerStop(psDatalog);
+        return;
+    }
+
+    _DataloggerServiceEnd(psDatalog);
+}
+
+//===================================================================================
+void DataloggerServiceTimebase (tDATALOGGER *psDatalog, uint8_t ui8Timebase)
+{
+    if (ui8Timebase == 0)
+    {
+        DataloggerService(psDatalog);
+        return;
+    }
+
+    // Triggers and the end of segments are handled by the base timebase
+    if (ui8Timebase >= DATALOGGER_MAX_TIMEBASES || psDatalog->eDatalogState != eDLOGSTATE_RUNNING || 
+        psDatalog->sSequence.ui8Armed)
+        return;
+
+    // Rate changes take effect at the tick boundary
+    if (psDatalog->sDatalogControl.ui8RateChanges)
+        _DataloggerApplyRateChanges(psDatalog, psDatalog->sTimebases.ui8Channels[ui8Timebase]);
 
-    if (bAbort_flag)
+    if (_DataloggerSampleChannels(psDatalog, psDatalog->sTimebases.ui8Channels[ui8Timebase]))
         DataloggerStop(psDatalog);
 }
 
+//===================================================================================
+/********************************************************************************//**
+ * \brief Common entry of the service routines.
+ *
+ * @returns true if the channels shall be sampled in this tick.
+ ***********************************************************************************/
+bool _DataloggerServiceBegin (tDATALOGGER *psDatalog)
+{
+    if (psDatalog->eDatalogState != eDLOGSTATE_RUNNING)
+        return false;
+
+    // Sequence mode: An armed segment waits for its trigger
+    if (psDatalog->sSequence.ui8Armed)
+    {
+        if (!psDatalog->sSequence.ui8TriggerPending)
+        {
+            psDatalog->sDatalogControl.ui32TickCount++;
+            return false;
+        }
+
+        _DataloggerStartSegment(psDatalog);
+    }
+
+    // Rate changes take effect at the tick boundary
+    if (psDatalog->sDatalogControl.ui8RateChanges)
+        _DataloggerApplyRateChanges(psDatalog, psDatalog->sTimebases.ui8Channels[0]);
+
+    return true;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Common exit of the service routines.
+ ***********************************************************************************/
+void _DataloggerServiceEnd (tDATALOGGER *psDatalog)
+{
+    psDatalog->sDatalogControl.ui32TickCount++;
+
+    // Ring channels continue at the start of their region
+    if (psDatalog->sSequence.eRearmMode == eSEQMODE_RING && 
+        (psDatalog->sDatalogControl.ui8ActiveLoggers & ~psDatalog->sDatalogControl.ui8ChannelsRunning))
+        _DataloggerRingWrap(psDatalog, psDatalog->sDatalogControl.ui8ActiveLoggers & ~psDatalog->sDatalogControl.ui8ChannelsRunning);
+
+    // If all channels reached the end of their segment, rearm or switch off datalogger
+    if ((psDatalog->sDatalogControl.ui8ActiveLoggers & psDatalog->sDatalogControl.ui8ChannelsRunning) == 0)
+        _DataloggerSegmentComplete(psDatalog);
+}
+
 //===================================================================================
 // Funktion: LiveModeTimerInit
 //===================================================================================
@@ -907,7 +3199,7 @@ void DataloggerStatemachine (tDATALOGGER *psDatalog)
         /*     if (++pMem_sched->ui8Arbitration_count >= sDatalog.sDatalog_internal.sHeader.ui8Active_loggers) */
         /*         sDatalog.eDatalog_state = eINT_MODE_READY_TO_START; */
         /* } */
-        if (psDatalog->sDatalogControl.eOpMode == eOPMODE_RECMODERAM)
+        if (CAPTURE_BUFFER_MODE(psDatalog))
         {
             psDatalog->eDatalogStatePending = eDLOGSTATE_DATA_READY;
         }
@@ -934,76 +3226,6 @@ void DataloggerStatemachine (tDATALOGGER *psDatalog)
 
 /*        break;*/
 
-/*    case eMEMORY_READ:*/
-/*        // Check, ob der Sendebuffer voll ist*/
-/*        if (sRoboard_interface.sData_in_endpoint.eBuffer_state == eLOW_FULL_HIGH_FULL)*/
-/*            break;*/
-
-/*        // Auch wenn gerade ein Transfer l�uft, darf die Funktion nicht betreten werden*/
-       /*if (sRoboard_interface.sData_in_endpoint.eTransfer_state == eTRANSFER_LOW ||
-               sRoboard_interface.sData_in_endpoint.eTransfer_state == eTRANSFER_HIGH)
-           break;*/
-
-/*        // Wenn das F-RAM bereit ist, Datenbulk lesen*/
-/*        if (sFram_interface.eState == eIDLE)*/
-/*        {*/
-/*            // K�nnen wir die maximale Anzahl an Datenbytes aus dem Speicher lesen?*/
-/*            ui32Memory_address_temp = sDatalog.sMemory_read.ui32Memory_offset + sRoboard_interface.sData_in_endpoint.ui16Max_data_to_write;*/
-
-
-
-/*            if(ui32Memory_address_temp <= sDatalog.sMemory_read.ui32Last_address)*/
-/*                ui16Max_bytes_temp = sRoboard_interface.sData_in_endpoint.ui16Max_data_to_write;*/
-/*            else*/
-/*            {*/
-
-/*                ui16Max_bytes_temp = (uint16_t)(sDatalog.sMemory_read.ui32Last_address - sDatalog.sMemory_read.ui32Memory_offset + 1);*/
-/*                // Daten�bertragung Ende: Zustandswechsel*/
-/*                sDatalog.eDatalog_state = eFINISH_MEMORY_READ;*/
-
-/*                // Sofort raus, wenn keine Daten mehr zu schreiben sind*/
-/*                if (!ui16Max_bytes_temp)*/
-/*                    break;*/
-/*            }*/
-
-/*            ui16End_index = SetDataInBufferWriteIndex(ui16Max_bytes_temp);*/
-/*            // Memory-Read ausl�sen. Da wir beim Memory Read direkt den Z�hlindex vom USB EP1 Datenbuffer verwenden,*/
-/*            // muss dieser vorher noch auf die richtige Stelle gesetzt werden (SetDataInBufferWriteIndex).*/
-/*            fram_initiate_transaction (ui16End_index, sDatalog.sMemory_read.ui32Memory_offset,*/
-/*                                       &sRoboard_interface.sData_in_endpoint.ui8Endpoint_data[0],*/
-/*                                       &sRoboard_interface.sData_in_endpoint.ui16Buffer_write_index, true, true);*/
-
-/*            // Memory Offset anpassen*/
-/*            sDatalog.sMemory_read.ui32Memory_offset += ui16Max_bytes_temp;*/
-/*        }*/
-
-        break;
-    // Hier signalisieren, dass die letzten Bytes durch den Kommunikationskanal geschoben werden k�nnen
-    /* case eFINISH_MEMORY_READ: */
-
-
-    /*     // Wenn alle Daten aus dem Memory �bertragen wurden, alle Transfers abschlie�en. Achtung! Dabei werden */
-    /*     // auch eventuelle noch verbliebene Restbytes aus dem Buffer �bertragen! (Daten-Packet auf dem USB-Bus */
-    /*     // sind immer 64 Bytes). F�r eine sinnvolle Datenauswertung auf dem Host muss ihm die richtige Datenl�nge */
-    /*     // also bekannt sein! */
-    /*     if (sFram_interface.eState == eIDLE) */
-    /*     { */
-    /*         sRoboard_interface.sData_in_endpoint.bConclude_transfer = true; */
-
-    /*         // �bertragungskanal wieder schlie�en. Dabei warten, bis die FSM f�r den Data Endpoint die Transaktion */
-    /*         // abgeschlossen hat (Signalisierung durch R�cknahme des bConclude_transfer Flags) */
-    /*         if (sRoboard_interface.sData_in_endpoint.eBuffer_state == eLOW_EMPTY_HIGH_EMPTY && */
-    /*             sRoboard_interface.sData_in_endpoint.bTransfer_concluded == true) */
-    /*         { */
-    /*             //USBEndpointDataSend(USB0_BASE, USB_EP_1, USB_TRANS_IN); */
-    /*             sRoboard_interface.sData_in_endpoint.bEndpoint_active = false; */
-    /*             // Alten Datenloggerzustand wieder herstellen */
-    /*             sDatalog.eDatalog_state = sDatalog.eDatalog_old_state; */
-    /*         } */
-    /*     } */
-
-    /*     break; */
-
     default:
         break;
     }
@@ -1064,6 +3286,8 @@ void DataloggerSetState(tDATALOGGER *psDatalog)
             switch(psDatalog->eDatalogStatePending)
             {
                 case eDLOGSTATE_DATA_READY:
+                    // Publish the recorded buffer for readout
+                    _DataloggerPublishCapture(psDatalog);
                     successFlag = true;
                     break;
                 
@@ -0,0 +1,319 @@
+/********************************************************************************//**
+ * \file DataloggerBlackBox.c
+ * \author Roman Holderried
+ *
+ * \brief Flight recorder: Always-on ring capture, frozen on a fault and persisted
+ * to non-volatile storage outside the interrupt context.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+#include "DataloggerExport.h"
+#include "DataloggerCrc.h"
+#include "DataloggerStorage.h"
+#include "DataloggerBlackBox.h"
+
+/************************************************************************************
+ * Private function definitions
+ ***********************************************************************************/
+static inline void _BlackBoxPut32 (uint8_t *pui8Dst, uint32_t ui32Val)
+{
+    for (uint8_t i = 0; i < 4; i++)
+        pui8Dst[i] = (uint8_t)(ui32Val >> (8 * i));
+}
+
+//===================================================================================
+static inline uint32_t _BlackBoxGet32 (const uint8_t *pui8Src)
+{
+    return (uint32_t)pui8Src[0] | ((uint32_t)pui8Src[1] << 8) | 
+           ((uint32_t)pui8Src[2] << 16) | ((uint32_t)pui8Src[3] << 24);
+}
+
+//===================================================================================
+static inline bool _BlackBoxBusy (tDATALOG_BLACKBOX *pBB)
+{
+    return pBB->pStorage->IsBusy != NULL && pBB->pStorage->IsBusy(pBB->pStorage->pvCtx);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Gives up the persist and releases the capture.
+ ***********************************************************************************/
+static tDATALOG_ERROR _BlackBoxAbandon (tDATALOG_BLACKBOX *pBB, tDATALOG_ERROR eError)
+{
+    DataloggerUnlockReadout(pBB->psDatalog, pBB->ui8BufIdx);
+    pBB->ui8Frozen = 0;
+    pBB->eState = eBLACKBOX_IDLE;
+
+    return eError;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Locks the published capture, collects its parts and erases the region.
+ ***********************************************************************************/
+static tDATALOG_ERROR _BlackBoxBegin (tDATALOG_BLACKBOX *pBB)
+{
+    tDATALOG_CHANNEL_VIEW sView;
+    uint32_t ui32ImageLen;
+    tDATALOG_ERROR eError;
+
+    eError = DataloggerLockReadout(pBB->psDatalog, &pBB->ui8BufIdx);
+
+    if (eError != eDATALOG_ERROR_NONE)
+        return eError;
+
+    pBB->pui8Part[0] = pBB->ui8Header;
+    pBB->ui32PartLen[0] = DataloggerExportHeader(pBB->psDatalog, pBB->ui8Header);
+    pBB->ui8PartCount = 1;
+    ui32ImageLen = pBB->ui32PartLen[0];
+
+    for (uint8_t i = 1; i <= MAX_NUM_LOGS; i++)
+    {
+        if (DataloggerGetChannelView(pBB->psDatalog, &sView, i) != eDATALOG_ERROR_NONE)
+            continue;
+
+        pBB->pui8Part[pBB->ui8PartCount] = sView.pui8Base;
+        pBB->ui32PartLen[pBB->ui8PartCount] = DataloggerViewGetLength(&sView);
+        ui32ImageLen += pBB->ui32PartLen[pBB->ui8PartCount++];
+    }
+
+    if (ui32ImageLen > pBB->ui32Size - DATALOGGER_BLACKBOX_COMMIT_SIZE)
+        return _BlackBoxAbandon(pBB, eDATALOG_ERROR_NOT_ENOUGH_MEMORY);
+
+    memcpy(pBB->ui8Commit, "DLBB", 4);
+    _BlackBoxPut32(&pBB->ui8Commit[4], ui32ImageLen);
+    _BlackBoxPut32(&pBB->ui8Commit[12], pBB->ui32Reason);
+
+    pBB->ui8Part = 0;
+    pBB->ui32PartPos = 0;
+    pBB->ui32Addr = pBB->ui32Base + DATALOGGER_BLACKBOX_COMMIT_SIZE;
+    pBB->ui32Checksum = DATALOGGER_CRC32_INIT;
+    pBB->eState = eBLACKBOX_ERASE;
+
+    // Erasing the commit block invalidates the previous image
+    eError = pBB->pStorage->Erase(pBB->ui32Base, DATALOGGER_BLACKBOX_COMMIT_SIZE + ui32ImageLen, pBB->pStorage->pvCtx);
+
+    if (eError != eDATALOG_ERROR_NONE)
+        return _BlackBoxAbandon(pBB, eError);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+/************************************************************************************
+ * Function definitions
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerBlackBoxInit (tDATALOG_BLACKBOX *pBB, tDATALOGGER *psDatalog, const tDATALOG_STORAGE *pStorage, 
+                                       uint32_t ui32Base, uint32_t ui32Size)
+{
+    if (pStorage->Write == NULL || pStorage->Read == NULL || pStorage->Erase == NULL)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    if (ui32Size <= DATALOGGER_BLACKBOX_COMMIT_SIZE)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    if (psDatalog->sDatalogControl.eOpMode != eOPMODE_RECMODERAM)
+        return eDATALOG_ERROR_WRONG_OPMODE;
+
+    memset(pBB, 0, sizeof(*pBB));
+    pBB->psDatalog = psDatalog;
+    pBB->pStorage = pStorage;
+    pBB->ui32Base = ui32Base;
+    pBB->ui32Size = ui32Size;
+    pBB->eState = eBLACKBOX_IDLE;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerBlackBoxStart (tDATALOG_BLACKBOX *pBB)
+{
+    tDATALOG_ERROR eError;
+
+    if (pBB->eState != eBLACKBOX_IDLE && pBB->eState != eBLACKBOX_DONE)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    if (pBB->psDatalog->sSequence.eRearmMode != eSEQMODE_RING || 
+        pBB->psDatalog->eDatalogState == eDLOGSTATE_UNINITIALIZED)
+    {
+        eError = DataloggerSetSequence(pBB->psDatalog, 1, eSEQMODE_RING);
+
+        if (eError == eDATALOG_ERROR_NONE)
+            eError = DataloggerInitLogger(pBB->psDatalog, true);
+
+        if (eError != eDATALOG_ERROR_NONE)
+            return eError;
+    }
+
+    pBB->ui8Frozen = 0;
+    pBB->eState = eBLACKBOX_IDLE;
+
+    return DataloggerStart(pBB->psDatalog);
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerBlackBoxFreeze (tDATALOG_BLACKBOX *pBB, uint32_t ui32Reason)
+{
+    if (pBB->ui8Frozen || pBB->psDatalog->eDatalogState != eDLOGSTATE_RUNNING)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    pBB->ui32Reason = ui32Reason;
+    pBB->ui8Frozen = 1;
+    DataloggerStop(pBB->psDatalog);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerBlackBoxService (tDATALOG_BLACKBOX *pBB)
+{
+    tDATALOG_ERROR eError;
+
+    switch (pBB->eState)
+    {
+        case eBLACKBOX_IDLE:
+            // Wait for the statemachine to publish the frozen capture
+            if (pBB->ui8Frozen && pBB->psDatalog->eDatalogState == eDLOGSTATE_DATA_READY)
+                return _BlackBoxBegin(pBB);
+            break;
+
+        case eBLACKBOX_ERASE:
+            if (!_BlackBoxBusy(pBB))
+                pBB->eState = eBLACKBOX_WRITE;
+            break;
+
+        case eBLACKBOX_WRITE:
+        {
+            const uint8_t *pui8Src;
+            uint32_t ui32Chunk;
+
+            if (_BlackBoxBusy(pBB))
+                break;
+
+            if (pBB->ui8Part >= pBB->ui8PartCount)
+            {
+                _BlackBoxPut32(&pBB->ui8Commit[8], pBB->ui32Checksum);
+                pBB->eState = eBLACKBOX_COMMIT;
+
+                eError = pBB->pStorage->Write(pBB->ui32Base, pBB->ui8Commit, DATALOGGER_BLACKBOX_COMMIT_SIZE, pBB->pStorage->pvCtx);
+
+                if (eError != eDATALOG_ERROR_NONE)
+                    return _BlackBoxAbandon(pBB, eError);
+                break;
+            }
+
+            pui8Src = &pBB->pui8Part[pBB->ui8Part][pBB->ui32PartPos];
+            ui32Chunk = pBB->ui32PartLen[pBB->ui8Part] - pBB->ui32PartPos;
+
+            if (ui32Chunk > DATALOGGER_BLACKBOX_CHUNK)
+                ui32Chunk = DATALOGGER_BLACKBOX_CHUNK;
+
+            eError = pBB->pStorage->Write(pBB->ui32Addr, pui8Src, ui32Chunk, pBB->pStorage->pvCtx);
+
+            if (eError != eDATALOG_ERROR_NONE)
+                return _BlackBoxAbandon(pBB, eError);
+
+            pBB->ui32Checksum = DataloggerCrc32Update(pBB->ui32Checksum, pui8Src, ui32Chunk);
+            pBB->ui32Addr += ui32Chunk;
+            pBB->ui32PartPos += ui32Chunk;
+
+            if (pBB->ui32PartPos >= pBB->ui32PartLen[pBB->ui8Part])
+            {
+                pBB->ui8Part++;
+                pBB->ui32PartPos = 0;
+            }
+            break;
+        }
+
+        case eBLACKBOX_COMMIT:
+            if (_BlackBoxBusy(pBB))
+                break;
+
+            DataloggerUnlockReadout(pBB->psDatalog, pBB->ui8BufIdx);
+            pBB->ui8Frozen = 0;
+            pBB->eState = eBLACKBOX_DONE;
+            break;
+
+        case eBLACKBOX_DONE:
+        default:
+            break;
+    }
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerBlackBoxRecover (tDATALOG_BLACKBOX *pBB, tDATALOG_BLACKBOX_IMAGE *pImage)
+{
+    uint8_t ui8Buf[DATALOGGER_BLACKBOX_CHUNK < DATALOGGER_BLACKBOX_COMMIT_SIZE ? DATALOGGER_BLACKBOX_COMMIT_SIZE : DATALOGGER_BLACKBOX_CHUNK];
+    uint32_t ui32Checksum = DATALOGGER_CRC32_INIT;
+    uint32_t ui32Len, ui32Expected, ui32Reason;
+    tDATALOG_ERROR eError;
+
+    if (pBB->eState != eBLACKBOX_IDLE && pBB->eState != eBLACKBOX_DONE)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    eError = pBB->pStorage->Read(pBB->ui32Base, ui8Buf, DATALOGGER_BLACKBOX_COMMIT_SIZE, pBB->pStorage->pvCtx);
+
+    if (eError != eDATALOG_ERROR_NONE)
+        return eError;
+
+    ui32Len = _BlackBoxGet32(&ui8Buf[4]);
+    ui32Expected = _BlackBoxGet32(&ui8Buf[8]);
+    ui32Reason = _BlackBoxGet32(&ui8Buf[12]);
+
+    if (memcmp(ui8Buf, "DLBB", 4) != 0 || ui32Len > pBB->ui32Size - DATALOGGER_BLACKBOX_COMMIT_SIZE)
+        return eDATALOG_ERROR_NO_DATA;
+
+    for (uint32_t ui32Pos = 0; ui32Pos < ui32Len; ui32Pos += sizeof(ui8Buf))
+    {
+        uint32_t ui32Chunk = ui32Len - ui32Pos < sizeof(ui8Buf) ? ui32Len - ui32Pos : sizeof(ui8Buf);
+
+        eError = DataloggerBlackBoxRead(pBB, ui32Pos, ui8Buf, ui32Chunk);
+
+        if (eError != eDATALOG_ERROR_NONE)
+            return eError;
+
+        ui32Checksum = DataloggerCrc32Update(ui32Checksum, ui8Buf, ui32Chunk);
+    }
+
+    if (ui32Checksum != ui32Expected)
+        return eDATALOG_ERROR_NO_DATA;
+
+    pImage->ui32Length = ui32Len;
+    pImage->ui32Reason = ui32Reason;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerBlackBoxRead (tDATALOG_BLACKBOX *pBB, uint32_t ui32Offset, uint8_t *pui8Data, uint32_t ui32Len)
+{
+    uint32_t ui32Avail = pBB->ui32Size - DATALOGGER_BLACKBOX_COMMIT_SIZE;
+
+    if (ui32Offset > ui32Avail || ui32Len > ui32Avail - ui32Offset)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    return pBB->pStorage->Read(pBB->ui32Base + DATALOGGER_BLACKBOX_COMMIT_SIZE + ui32Offset, pui8Data, ui32Len, pBB->pStorage->pvCtx);
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerBlackBoxClear (tDATALOG_BLACKBOX *pBB)
+{
+    if (pBB->eState != eBLACKBOX_IDLE && pBB->eState != eBLACKBOX_DONE)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    return pBB->pStorage->Erase(pBB->ui32Base, DATALOGGER_BLACKBOX_COMMIT_SIZE, pBB->pStorage->pvCtx);
+}
+
+// EOF
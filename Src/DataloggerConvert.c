@@ -0,0 +1,202 @@
+/********************************************************************************//**
+ * \file DataloggerConvert.c
+ * \author Roman Holderried
+ *
+ * \brief Bulk conversion of captured channels into engineering units.
+ *
+ * The conversion loops are specialized for every sample width and data type, so
+ * the loop bodies are free of branches and can be vectorized by the compiler.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+#include "DataloggerConvert.h"
+
+/************************************************************************************
+ * Defines
+ ***********************************************************************************/
+// Big endian raw value assembly of sample i (p points to the first sample)
+#define BE16(p, i)  ((uint16_t)(((uint16_t)(p)[2*(i)] << 8) | (p)[2*(i) + 1]))
+#define BE32(p, i)  (((uint32_t)(p)[4*(i)] << 24) | ((uint32_t)(p)[4*(i) + 1] << 16) | \
+                     ((uint32_t)(p)[4*(i) + 2] << 8) | (uint32_t)(p)[4*(i) + 3])
+#define BE64(p, i)  (((uint64_t)BE32((p) + 8*(i), 0) << 32) | (uint64_t)BE32((p) + 8*(i) + 4, 0))
+
+/** Loop over all samples, RAW is the raw value expression of sample i */
+#define CONVERT_LOOP(DST, RAW) \
+    for (uint32_t i = 0; i < ui32Count; i++) \
+        (DST)[i] = (RAW) * gain + offset
+
+/** Chunk size of the bit packed conversion */
+#define CONVERT_CHUNK   32
+
+/** Conversion of bit packed views: word wise unpacking into a chunk buffer */
+#define CONVERT_PACKED(DST) \
+    for (uint32_t c = 0; c < ui32Count; c += CONVERT_CHUNK) \
+    { \
+        uint32_t ui32Raw[CONVERT_CHUNK]; \
+        uint32_t n = (ui32Count - c < CONVERT_CHUNK) ? ui32Count - c : CONVERT_CHUNK; \
+        DataloggerViewUnpack(pView, ui32Raw, ui32Start + c, n); \
+        if (pScaling->eType == eDATALOG_TYPE_INT) \
+            for (uint32_t i = 0; i < n; i++) \
+                (DST)[c + i] = ((int64_t)(ui32Raw[i] ^ ui32Sign) - ui32Sign) * gain + offset; \
+        else \
+            for (uint32_t i = 0; i < n; i++) \
+                (DST)[c + i] = ui32Raw[i] * gain + offset; \
+    }
+
+/** Conversion body shared by the float and double conversion */
+#define CONVERT_BODY(DST) \
+    switch ((pScaling->eType << 4) | pView->ui8Width) \
+    { \
+        case (eDATALOG_TYPE_UINT << 4) | 1:     CONVERT_LOOP(DST, pui8Src[i]); break; \
+        case (eDATALOG_TYPE_INT << 4) | 1:      CONVERT_LOOP(DST, (int8_t)pui8Src[i]); break; \
+        case (eDATALOG_TYPE_UINT << 4) | 2:     CONVERT_LOOP(DST, BE16(pui8Src, i)); break; \
+        case (eDATALOG_TYPE_INT << 4) | 2:      CONVERT_LOOP(DST, (int16_t)BE16(pui8Src, i)); break; \
+        case (eDATALOG_TYPE_UINT << 4) | 4:     CONVERT_LOOP(DST, BE32(pui8Src, i)); break; \
+        case (eDATALOG_TYPE_INT << 4) | 4:      CONVERT_LOOP(DST, (int32_t)BE32(pui8Src, i)); break; \
+        case (eDATALOG_TYPE_FLOAT << 4) | 4:    CONVERT_LOOP(DST, _BitsToFloat(BE32(pui8Src, i))); break; \
+        case (eDATALOG_TYPE_UINT << 4) | 8:     CONVERT_LOOP(DST, BE64(pui8Src, i)); break; \
+        case (eDATALOG_TYPE_INT << 4) | 8:      CONVERT_LOOP(DST, (int64_t)BE64(pui8Src, i)); break; \
+        case (eDATALOG_TYPE_FLOAT << 4) | 8:    CONVERT_LOOP(DST, _BitsToDouble(BE64(pui8Src, i))); break; \
+        default:                                CONVERT_LOOP(DST, _ConvertGeneric(pView, pScaling, ui32Start + i)); break; \
+    }
+
+/************************************************************************************
+ * Private function definitions
+ ***********************************************************************************/
+static inline float _BitsToFloat(uint32_t ui32Bits)
+{
+    float f;
+    memcpy(&f, &ui32Bits, sizeof(f));
+    return f;
+}
+
+static inline double _BitsToDouble(uint64_t ui64Bits)
+{
+    double d;
+    memcpy(&d, &ui64Bits, sizeof(d));
+    return d;
+}
+
+/********************************************************************************//**
+ * \brief Unscaled conversion of a single sample with an arbitrary width.
+ ***********************************************************************************/
+static double _ConvertGeneric(const tDATALOG_CHANNEL_VIEW *pView, const tDATALOG_SCALING *pScaling, uint32_t ui32Idx)
+{
+    uint64_t ui64Raw = DataloggerViewGetSample(pView, ui32Idx);
+    uint8_t ui8Bits = (pView->eEncoding == eDATALOG_ENCODING_BITPACKED) ? pView->ui8BitWidth : pView->ui8Width << 3;
+
+    if (pScaling->eType == eDATALOG_TYPE_FLOAT)
+        return ui8Bits == 32 ? (double)_BitsToFloat((uint32_t)ui64Raw) : _BitsToDouble(ui64Raw);
+
+    if (pScaling->eType == eDATALOG_TYPE_INT && ui8Bits < 64 && (ui64Raw & ((uint64_t)1 << (ui8Bits - 1))))
+        return (double)(int64_t)(ui64Raw | (~(uint64_t)0 << ui8Bits));
+
+    return (double)ui64Raw;
+}
+
+//===================================================================================
+static tDATALOG_ERROR _ConvertCheckArgs(const tDATALOG_CHANNEL_VIEW *pView, const tDATALOG_SCALING *pScaling, uint32_t ui32Start, uint32_t ui32Count)
+{
+    if (pView->pui8Base == NULL && pView->ui32Count > 0)
+        return eDATALOG_ERROR_NO_DATA;
+
+    if (ui32Start > pView->ui32Count || ui32Count > pView->ui32Count - ui32Start)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    if (pView->ui8Width == 0 || pView->ui8Width > 8)
+        return eDATALOG_ERROR_NOT_IMPLEMENTED;
+
+    if (pView->eEncoding == eDATALOG_ENCODING_BITPACKED)
+    {
+        if (pScaling->eType == eDATALOG_TYPE_FLOAT)
+            return eDATALOG_ERROR_INVALID_PARAMETER;
+    }
+    else if (pView->eEncoding != eDATALOG_ENCODING_BE && pView->eEncoding != eDATALOG_ENCODING_NATIVE)
+        return eDATALOG_ERROR_NOT_IMPLEMENTED;
+    else if (pScaling->eType == eDATALOG_TYPE_FLOAT && pView->ui8Width != 4 && pView->ui8Width != 8)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+/************************************************************************************
+ * Function definitions
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerConvertToFloat(const tDATALOG_CHANNEL_VIEW *pView, const tDATALOG_SCALING *pScaling, float *pfDst, uint32_t ui32Start, uint32_t ui32Count)
+{
+    const float gain = pScaling->fGain;
+    const float offset = pScaling->fOffset;
+    const uint8_t *pui8Src;
+    tDATALOG_ERROR eError = _ConvertCheckArgs(pView, pScaling, ui32Start, ui32Count);
+
+    if (eError != eDATALOG_ERROR_NONE)
+        return eError;
+
+    // Only formed once ui32Start is known to be inside the view
+    pui8Src = pView->pui8Base + ui32Start * pView->ui16Stride;
+
+    if (pView->eEncoding == eDATALOG_ENCODING_BITPACKED)
+    {
+        // Sign extension of ui8BitWidth bit values: (x ^ sign) - sign
+        const uint32_t ui32Sign = (uint32_t)1 << (pView->ui8BitWidth - 1);
+
+        CONVERT_PACKED(pfDst);
+    }
+    // Densely packed big endian samples take the specialized loops
+    else if (pView->eEncoding == eDATALOG_ENCODING_BE && pView->ui16Stride == pView->ui8Width)
+    {
+        CONVERT_BODY(pfDst);
+    }
+    else
+    {
+        CONVERT_LOOP(pfDst, (float)_ConvertGeneric(pView, pScaling, ui32Start + i));
+    }
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerConvertToDouble(const tDATALOG_CHANNEL_VIEW *pView, const tDATALOG_SCALING *pScaling, double *pdDst, uint32_t ui32Start, uint32_t ui32Count)
+{
+    const double gain = pScaling->fGain;
+    const double offset = pScaling->fOffset;
+    const uint8_t *pui8Src;
+    tDATALOG_ERROR eError = _ConvertCheckArgs(pView, pScaling, ui32Start, ui32Count);
+
+    if (eError != eDATALOG_ERROR_NONE)
+        return eError;
+
+    // Only formed once ui32Start is known to be inside the view
+    pui8Src = pView->pui8Base + ui32Start * pView->ui16Stride;
+
+    if (pView->eEncoding == eDATALOG_ENCODING_BITPACKED)
+    {
+        // Sign extension of ui8BitWidth bit values: (x ^ sign) - sign
+        const uint32_t ui32Sign = (uint32_t)1 << (pView->ui8BitWidth - 1);
+
+        CONVERT_PACKED(pdDst);
+    }
+    // Densely packed big endian samples take the specialized loops
+    else if (pView->eEncoding == eDATALOG_ENCODING_BE && pView->ui16Stride == pView->ui8Width)
+    {
+        CONVERT_BODY(pdDst);
+    }
+    else
+    {
+        CONVERT_LOOP(pdDst, _ConvertGeneric(pView, pScaling, ui32Start + i));
+    }
+
+    return eDATALOG_ERROR_NONE;
+}
+// EOF
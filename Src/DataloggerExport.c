@@ -0,0 +1,276 @@
+/********************************************************************************//**
+ * \file DataloggerExport.c
+ * \author Roman Holderried
+ *
+ * \brief Streaming export of captures to a file descriptor (host builds only),
+ * portable builder of the stream header.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+#if !defined(_POSIX_C_SOURCE) && !defined(_DEFAULT_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+#include "DataloggerExport.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <sys/uio.h>
+#endif
+
+/************************************************************************************
+ * Private function definitions
+ ***********************************************************************************/
+static inline void _ExportPut16 (uint8_t *pui8Dst, uint16_t ui16Val)
+{
+    pui8Dst[0] = (uint8_t)ui16Val;
+    pui8Dst[1] = (uint8_t)(ui16Val >> 8);
+}
+
+static inline void _ExportPut32 (uint8_t *pui8Dst, uint32_t ui32Val)
+{
+    _ExportPut16(pui8Dst, (uint16_t)ui32Val);
+    _ExportPut16(pui8Dst + 2, (uint16_t)(ui32Val >> 16));
+}
+
+static inline void _ExportPutFloat (uint8_t *pui8Dst, float fVal)
+{
+    uint32_t ui32Bits;
+
+    memcpy(&ui32Bits, &fVal, sizeof(ui32Bits));
+    _ExportPut32(pui8Dst, ui32Bits);
+}
+
+/************************************************************************************
+ * Function definitions
+ ***********************************************************************************/
+uint32_t DataloggerExportHeader (tDATALOGGER *psDatalog, uint8_t *pui8Header)
+{
+    tDATALOG_CHANNEL_VIEW sView;
+    tDATALOG_SCALING sScaling;
+    tDATALOG_SEGMENT sSegment;
+    tDATALOG_RATE_MARKER sMarker;
+    uint8_t *pui8Desc = &pui8Header[DATALOGGER_EXPORT_FILE_HEADER_SIZE];
+    uint16_t ui16Segments = 0;
+    uint16_t ui16Markers = 0;
+    uint8_t ui8Channels = 0;
+    uint32_t ui32Size;
+
+    while (DataloggerGetSegmentInfo(psDatalog, &sSegment, ui16Segments) == eDATALOG_ERROR_NONE)
+        ui16Segments++;
+
+    if (ui16Segments == 0)
+        return 0;
+
+    for (uint8_t i = 1; i <= MAX_NUM_LOGS; i++)
+    {
+        uint32_t ui32FirstTick = 0;
+        uint16_t ui16Divider = 0;
+
+        if (DataloggerGetChannelView(psDatalog, &sView, i) != eDATALOG_ERROR_NONE)
+            continue;
+
+        DataloggerGetChannelScaling(psDatalog, &sScaling, i);
+        DataloggerGetSampleTick(psDatalog, i, 0, &ui32FirstTick);
+        DataloggerGetCaptureDivider(psDatalog, i, &ui16Divider);
+
+        memset(pui8Desc, 0, DATALOGGER_EXPORT_CHANNEL_HEADER_SIZE);
+        _ExportPut32(&pui8Desc[0], psDatalog->sDatalogControl.sDatalogChannels[i - 1].ui32ChID);
+        pui8Desc[4] = i;
+        pui8Desc[5] = (uint8_t)sView.eEncoding;
+        pui8Desc[6] = sView.ui8Width;
+        pui8Desc[7] = sView.ui8BitWidth;
+        _ExportPut16(&pui8Desc[8], ui16Divider);
+        pui8Desc[10] = (uint8_t)sScaling.eType;
+        pui8Desc[11] = (uint8_t)DataloggerGetChannelKind(&psDatalog->sDatalogControl.sDatalogChannels[i - 1]);
+        _ExportPut32(&pui8Desc[12], sView.ui32Count);
+        _ExportPut32(&pui8Desc[16], DataloggerViewGetLength(&sView));
+        _ExportPutFloat(&pui8Desc[20], sScaling.fGain);
+        _ExportPutFloat(&pui8Desc[24], sScaling.fOffset);
+        _ExportPut32(&pui8Desc[28], ui32FirstTick);
+        pui8Desc += DATALOGGER_EXPORT_CHANNEL_HEADER_SIZE;
+        ui8Channels++;
+    }
+
+    // Runtime divider changes, in order of the ticks
+    while (DataloggerGetRateMarker(psDatalog, &sMarker, ui16Markers) == eDATALOG_ERROR_NONE)
+    {
+        memset(pui8Desc, 0, DATALOGGER_EXPORT_MARKER_SIZE);
+        pui8Desc[0] = sMarker.ui8LogNum;
+        _ExportPut16(&pui8Desc[2], sMarker.ui16OldDivider);
+        _ExportPut16(&pui8Desc[4], sMarker.ui16Divider);
+        _ExportPut32(&pui8Desc[8], sMarker.ui32SampleIdx);
+        _ExportPut32(&pui8Desc[12], sMarker.ui32Tick);
+        pui8Desc += DATALOGGER_EXPORT_MARKER_SIZE;
+        ui16Markers++;
+    }
+
+    ui32Size = (uint32_t)(pui8Desc - pui8Header);
+
+    memset(pui8Header, 0, DATALOGGER_EXPORT_FILE_HEADER_SIZE);
+    memcpy(pui8Header, "DLOG", 4);
+    pui8Header[4] = DATALOGGER_VERSION_MAJOR;
+    pui8Header[5] = DATALOGGER_VERSION_MINOR;
+    pui8Header[6] = ui8Channels;
+    pui8Header[7] = DataloggerExportTrailer(psDatalog, NULL) ? DATALOGGER_EXPORT_FLAG_CRC : 0;
+    _ExportPut16(&pui8Header[8], ui16Segments);
+    _ExportPut16(&pui8Header[10], ui16Markers);
+    _ExportPut32(&pui8Header[12], ui32Size);
+
+    return ui32Size;
+}
+
+//===================================================================================
+uint32_t DataloggerExportTrailer (tDATALOGGER *psDatalog, uint8_t *pui8Trailer)
+{
+    tDATALOG_CHANNEL_VIEW sView;
+    uint32_t ui32Size = 8;
+    uint32_t ui32Crc;
+    bool bCrc = false;
+
+    for (uint8_t i = 1; i <= MAX_NUM_LOGS; i++)
+    {
+        uint32_t ui32CountPos = ui32Size;
+        uint32_t ui32Blocks = 0;
+
+        if (DataloggerGetChannelView(psDatalog, &sView, i) != eDATALOG_ERROR_NONE)
+            continue;
+
+        // Channels without block CRCs are listed with a block count of 0
+        ui32Size += 4;
+
+        while (DataloggerGetBlockCrc(psDatalog, i, (uint16_t)ui32Blocks, &ui32Crc) == eDATALOG_ERROR_NONE)
+        {
+            if (pui8Trailer != NULL)
+                _ExportPut32(&pui8Trailer[ui32Size], ui32Crc);
+
+            ui32Size += 4;
+            ui32Blocks++;
+            bCrc = true;
+        }
+
+        if (pui8Trailer != NULL)
+            _ExportPut32(&pui8Trailer[ui32CountPos], ui32Blocks);
+    }
+
+    if (!bCrc)
+        return 0;
+
+    if (pui8Trailer != NULL)
+    {
+        memcpy(pui8Trailer, "DLCR", 4);
+        _ExportPut32(&pui8Trailer[4], DATALOGGER_CRC_BLOCK_SIZE);
+    }
+
+    return ui32Size;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+//===================================================================================
+/********************************************************************************//**
+ * \brief writev of the complete vector, continued after partial writes.
+ ***********************************************************************************/
+static tDATALOG_ERROR _ExportWritev (int iFd, struct iovec *psIov, int iCount)
+{
+    while (iCount > 0)
+    {
+        ssize_t sWritten = writev(iFd, psIov, iCount);
+
+        if (sWritten < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return eDATALOG_ERROR_IO;
+        }
+
+        // Skip the completely written entries, adjust the partially written one
+        while (iCount > 0 && (size_t)sWritten >= psIov->iov_len)
+        {
+            sWritten -= (ssize_t)psIov->iov_len;
+            psIov++;
+            iCount--;
+        }
+
+        if (iCount > 0)
+        {
+            psIov->iov_base = (uint8_t*)psIov->iov_base + sWritten;
+            psIov->iov_len -= (size_t)sWritten;
+        }
+    }
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerExportCapture (tDATALOGGER *psDatalog, int iFd)
+{
+    uint8_t ui8Header[DATALOGGER_EXPORT_HEADER_MAX_SIZE];
+    uint8_t ui8Trailer[DATALOGGER_EXPORT_TRAILER_MAX_SIZE];
+    struct iovec sIov[2 + MAX_NUM_LOGS];
+    tDATALOG_CHANNEL_VIEW sView;
+    uint8_t ui8Channels = 0;
+    uint8_t ui8BufIdx;
+    tDATALOG_ERROR eError;
+
+    eError = DataloggerLockReadout(psDatalog, &ui8BufIdx);
+
+    if (eError != eDATALOG_ERROR_NONE)
+        return eError;
+
+    sIov[0].iov_base = ui8Header;
+    sIov[0].iov_len = DataloggerExportHeader(psDatalog, ui8Header);
+
+    // Channel data straight from the capture buffer
+    for (uint8_t i = 1; i <= MAX_NUM_LOGS; i++)
+    {
+        if (DataloggerGetChannelView(psDatalog, &sView, i) != eDATALOG_ERROR_NONE)
+            continue;
+
+        ui8Channels++;
+        sIov[ui8Channels].iov_base = (void*)sView.pui8Base;
+        sIov[ui8Channels].iov_len = DataloggerViewGetLength(&sView);
+    }
+
+    // Block CRCs of the channel data
+    sIov[ui8Channels + 1].iov_base = ui8Trailer;
+    sIov[ui8Channels + 1].iov_len = DataloggerExportTrailer(psDatalog, ui8Trailer);
+
+    eError = _ExportWritev(iFd, sIov, 2 + ui8Channels);
+
+    DataloggerUnlockReadout(psDatalog, ui8BufIdx);
+
+    return eError;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerExportBlock (int iFd, uint8_t ui8LogNum, uint32_t ui32FirstSample, const uint8_t *pui8Data, uint32_t ui32Len)
+{
+    uint8_t ui8Header[DATALOGGER_EXPORT_BLOCK_HEADER_SIZE] = {0};
+    struct iovec sIov[2];
+
+    memcpy(ui8Header, "DLBK", 4);
+    ui8Header[4] = ui8LogNum;
+    _ExportPut32(&ui8Header[8], ui32FirstSample);
+    _ExportPut32(&ui8Header[12], ui32Len);
+
+    sIov[0].iov_base = ui8Header;
+    sIov[0].iov_len = sizeof(ui8Header);
+    sIov[1].iov_base = (void*)pui8Data;
+    sIov[1].iov_len = ui32Len;
+
+    return _ExportWritev(iFd, sIov, 2);
+}
+
+#endif
+// EOF
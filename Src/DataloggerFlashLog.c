@@ -0,0 +1,487 @@
+/********************************************************************************//**
+ * \file DataloggerFlashLog.c
+ * \author Roman Holderried
+ *
+ * \brief Append-only capture log for NOR/NAND flash backends.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *
+ ***********************************************************************************/
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+#include "DataloggerCrc.h"
+#include "DataloggerStorage.h"
+#include "DataloggerFlashLog.h"
+
+/************************************************************************************
+ * Private function definitions
+ ***********************************************************************************/
+static inline void _FlashLogPut32 (uint8_t *pui8Dst, uint32_t ui32Val)
+{
+    for (uint8_t i = 0; i < 4; i++)
+        pui8Dst[i] = (uint8_t)(ui32Val >> (8 * i));
+}
+
+//===================================================================================
+static inline uint32_t _FlashLogGet32 (const uint8_t *pui8Src)
+{
+    return (uint32_t)pui8Src[0] | ((uint32_t)pui8Src[1] << 8) |
+           ((uint32_t)pui8Src[2] << 16) | ((uint32_t)pui8Src[3] << 24);
+}
+
+//===================================================================================
+static inline bool _FlashLogBusy (tDATALOG_FLASHLOG *pLog)
+{
+    return pLog->pStorage->IsBusy != NULL && pLog->pStorage->IsBusy(pLog->pStorage->pvCtx);
+}
+
+//===================================================================================
+static inline uint32_t _FlashLogPageAddr (tDATALOG_FLASHLOG *pLog, uint32_t ui32Seq)
+{
+    return pLog->ui32Base + (ui32Seq % pLog->ui32PageCount) * DATALOGGER_FLASHLOG_PAGE_SIZE;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Oldest page which is not erased when the page ui32Seq is written next.
+ *
+ * The erase block of the next page counts as erased.
+ ***********************************************************************************/
+static uint32_t _FlashLogOldestSeq (tDATALOG_FLASHLOG *pLog, uint32_t ui32Seq)
+{
+    uint32_t ui32BlockSeq = ui32Seq - ui32Seq % pLog->ui32PagesPerBlock;
+
+    if (ui32BlockSeq + pLog->ui32PagesPerBlock < pLog->ui32PageCount)
+        return 0;
+
+    return ui32BlockSeq + pLog->ui32PagesPerBlock - pLog->ui32PageCount;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Reads the page ui32Seq and checks its header and CRC.
+ *
+ * @returns true if the page is valid
+ ***********************************************************************************/
+static bool _FlashLogReadPage (tDATALOG_FLASHLOG *pLog, uint32_t ui32Seq, uint8_t *pui8Page, tDATALOG_ERROR *peError)
+{
+    uint16_t ui16Len;
+    uint32_t ui32Crc;
+
+    *peError = pLog->pStorage->Read(_FlashLogPageAddr(pLog, ui32Seq), pui8Page, DATALOGGER_FLASHLOG_PAGE_SIZE, pLog->pStorage->pvCtx);
+
+    if (*peError != eDATALOG_ERROR_NONE)
+        return false;
+
+    ui16Len = (uint16_t)(pui8Page[12] | (pui8Page[13] << 8));
+
+    if (memcmp(pui8Page, "DLPG", 4) != 0 || _FlashLogGet32(&pui8Page[4]) != ui32Seq ||
+        ui16Len > DATALOGGER_FLASHLOG_PAYLOAD_SIZE)
+        return false;
+
+    ui32Crc = DataloggerCrc32Update(DATALOGGER_CRC32_INIT, pui8Page, 16);
+    ui32Crc = DataloggerCrc32Update(ui32Crc, &pui8Page[DATALOGGER_FLASHLOG_HEADER_SIZE], ui16Len);
+
+    return ui32Crc == _FlashLogGet32(&pui8Page[16]);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Queues the page buffer being filled for the program.
+ ***********************************************************************************/
+static void _FlashLogQueue (tDATALOG_FLASHLOG *pLog, bool bEnd)
+{
+    pLog->ui8Queued |= (1 << pLog->ui8FillIdx);
+
+    if (bEnd)
+        pLog->ui8EndPage |= (1 << pLog->ui8FillIdx);
+
+    pLog->ui32CapturePages++;
+    pLog->ui8FillIdx ^= 1;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Takes over the finished storage access and starts the next one.
+ *
+ * @returns true if the next access can be started right away (blocking backend)
+ ***********************************************************************************/
+static bool _FlashLogStep (tDATALOG_FLASHLOG *pLog, tDATALOG_ERROR *peError)
+{
+    uint8_t ui8Idx = pLog->ui8ProgIdx;
+    uint8_t *pui8Page = pLog->ui8Page[ui8Idx];
+    uint16_t ui16Len;
+    uint32_t ui32Crc;
+
+    *peError = eDATALOG_ERROR_NONE;
+
+    if (_FlashLogBusy(pLog))
+        return false;
+
+    // The programmed page buffer is released after the program
+    if (pLog->ui8Programming)
+    {
+        if (pLog->ui8EndPage & (1 << ui8Idx))
+        {
+            pLog->sLatest.ui32FirstSeq = pLog->ui32CaptureSeq;
+            pLog->sLatest.ui32Length = pLog->ui32CaptureLen;
+            pLog->ui8LatestValid = 1;
+        }
+
+        pLog->ui8Queued &= ~(1 << ui8Idx);
+        pLog->ui8EndPage &= ~(1 << ui8Idx);
+        pLog->ui16FillLen[ui8Idx] = 0;
+        pLog->ui8ProgIdx ^= 1;
+        pLog->ui8Programming = 0;
+
+        ui8Idx = pLog->ui8ProgIdx;
+        pui8Page = pLog->ui8Page[ui8Idx];
+    }
+
+    if (!(pLog->ui8Queued & (1 << ui8Idx)))
+        return false;
+
+    // Erase the block before its first page, this drops its oldest pages
+    if (pLog->ui32Seq % pLog->ui32PagesPerBlock == 0 && !pLog->ui8Erased)
+    {
+        if (pLog->ui8LatestValid && pLog->sLatest.ui32FirstSeq < _FlashLogOldestSeq(pLog, pLog->ui32Seq))
+            pLog->ui8LatestValid = 0;
+
+        *peError = pLog->pStorage->Erase(_FlashLogPageAddr(pLog, pLog->ui32Seq), pLog->ui32BlockSize, pLog->pStorage->pvCtx);
+        pLog->ui8Erased = 1;
+
+        return *peError == eDATALOG_ERROR_NONE && !_FlashLogBusy(pLog);
+    }
+
+    ui16Len = pLog->ui16FillLen[ui8Idx];
+
+    memcpy(pui8Page, "DLPG", 4);
+    _FlashLogPut32(&pui8Page[4], pLog->ui32Seq);
+    _FlashLogPut32(&pui8Page[8], pLog->ui32CaptureSeq);
+    pui8Page[12] = (uint8_t)ui16Len;
+    pui8Page[13] = (uint8_t)(ui16Len >> 8);
+    pui8Page[14] = (pLog->ui8EndPage & (1 << ui8Idx)) ? DATALOGGER_FLASHLOG_FLAG_END : 0;
+    pui8Page[15] = 0;
+
+    ui32Crc = DataloggerCrc32Update(DATALOGGER_CRC32_INIT, pui8Page, 16);
+    _FlashLogPut32(&pui8Page[16], DataloggerCrc32Update(ui32Crc, &pui8Page[DATALOGGER_FLASHLOG_HEADER_SIZE], ui16Len));
+
+    // Whole pages are programmed, the rest stays erased
+    memset(&pui8Page[DATALOGGER_FLASHLOG_HEADER_SIZE + ui16Len], 0xFF, DATALOGGER_FLASHLOG_PAYLOAD_SIZE - ui16Len);
+
+    *peError = pLog->pStorage->Write(_FlashLogPageAddr(pLog, pLog->ui32Seq), pui8Page, DATALOGGER_FLASHLOG_PAGE_SIZE, pLog->pStorage->pvCtx);
+
+    if (*peError != eDATALOG_ERROR_NONE)
+        return false;
+
+    pLog->ui8Programming = 1;
+    pLog->ui8Erased = 0;
+    pLog->ui32Seq++;
+
+    return !_FlashLogBusy(pLog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Read function of the capture storage view.
+ ***********************************************************************************/
+static tDATALOG_ERROR _FlashLogViewRead (uint32_t ui32Addr, uint8_t *pui8Data, uint32_t ui32Len, void *pvCtx)
+{
+    tDATALOG_FLASHLOG *pLog = (tDATALOG_FLASHLOG*)pvCtx;
+
+    return DataloggerFlashLogRead(pLog, &pLog->sView, ui32Addr, pui8Data, ui32Len);
+}
+
+/************************************************************************************
+ * Function definitions
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerFlashLogInit (tDATALOG_FLASHLOG *pLog, const tDATALOG_STORAGE *pStorage,
+                                       uint32_t ui32Base, uint32_t ui32Size, uint32_t ui32BlockSize)
+{
+    if (pStorage == NULL || pStorage->Write == NULL || pStorage->Read == NULL || pStorage->Erase == NULL)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    // The erase blocks have to coincide with the erase blocks of the device
+    if (!ui32BlockSize || ui32BlockSize % DATALOGGER_FLASHLOG_PAGE_SIZE || ui32Base % ui32BlockSize ||
+        ui32Size % ui32BlockSize || ui32Size / ui32BlockSize < 2)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    memset(pLog, 0, sizeof(*pLog));
+    pLog->pStorage = pStorage;
+    pLog->ui32Base = ui32Base;
+    pLog->ui32BlockSize = ui32BlockSize;
+    pLog->ui32PagesPerBlock = ui32BlockSize / DATALOGGER_FLASHLOG_PAGE_SIZE;
+    pLog->ui32PageCount = ui32Size / DATALOGGER_FLASHLOG_PAGE_SIZE;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerFlashLogMount (tDATALOG_FLASHLOG *pLog)
+{
+    uint8_t ui8Page[DATALOGGER_FLASHLOG_PAGE_SIZE];
+    uint32_t ui32BlockSeq = 0;
+    uint32_t ui32Seq, ui32Oldest;
+    bool bFound = false;
+    tDATALOG_ERROR eError;
+
+    if (pLog->ui8Open || pLog->ui8Queued || pLog->ui8Programming)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    // Newest erase block: Highest sequence number of the first pages
+    for (uint32_t b = 0; b < pLog->ui32PageCount; b += pLog->ui32PagesPerBlock)
+    {
+        eError = pLog->pStorage->Read(pLog->ui32Base + b * DATALOGGER_FLASHLOG_PAGE_SIZE, ui8Page, DATALOGGER_FLASHLOG_HEADER_SIZE,
+                                      pLog->pStorage->pvCtx);
+
+        if (eError != eDATALOG_ERROR_NONE)
+            return eError;
+
+        ui32Seq = _FlashLogGet32(&ui8Page[4]);
+
+        if (memcmp(ui8Page, "DLPG", 4) != 0 || ui32Seq % pLog->ui32PageCount != b || (bFound && ui32Seq <= ui32BlockSeq))
+            continue;
+
+        if (!_FlashLogReadPage(pLog, ui32Seq, ui8Page, &eError))
+        {
+            if (eError != eDATALOG_ERROR_NONE)
+                return eError;
+            continue;
+        }
+
+        ui32BlockSeq = ui32Seq;
+        bFound = true;
+    }
+
+    pLog->ui8LatestValid = 0;
+    pLog->ui8Erased = 0;
+    pLog->ui32Seq = 0;
+    pLog->ui8Mounted = 1;
+
+    if (!bFound)
+        return eDATALOG_ERROR_NONE;
+
+    // Write position: First blank page of the newest block. Torn pages cannot be 
+    // programmed again before the next erase and are skipped.
+    for (ui32Seq = ui32BlockSeq + 1; ui32Seq < ui32BlockSeq + pLog->ui32PagesPerBlock; ui32Seq++)
+    {
+        bool bBlank = true;
+
+        if (_FlashLogReadPage(pLog, ui32Seq, ui8Page, &eError))
+            continue;
+
+        if (eError != eDATALOG_ERROR_NONE)
+            return eError;
+
+        for (uint8_t i = 0; i < DATALOGGER_FLASHLOG_HEADER_SIZE; i++)
+            bBlank = bBlank && ui8Page[i] == 0xFF;
+
+        if (bBlank)
+            break;
+    }
+
+    pLog->ui32Seq = ui32Seq;
+    ui32Oldest = _FlashLogOldestSeq(pLog, ui32Seq);
+
+    // Latest end page, pages of an interrupted capture are skipped
+    while (ui32Seq-- > ui32Oldest)
+    {
+        if (!_FlashLogReadPage(pLog, ui32Seq, ui8Page, &eError))
+        {
+            if (eError != eDATALOG_ERROR_NONE)
+                return eError;
+            continue;
+        }
+
+        if (!(ui8Page[14] & DATALOGGER_FLASHLOG_FLAG_END))
+            continue;
+
+        pLog->sLatest.ui32FirstSeq = _FlashLogGet32(&ui8Page[8]);
+        pLog->sLatest.ui32Length = (ui32Seq - pLog->sLatest.ui32FirstSeq) * DATALOGGER_FLASHLOG_PAYLOAD_SIZE +
+                                   (uint32_t)(ui8Page[12] | (ui8Page[13] << 8));
+
+        // The beginning of the capture may have been erased already
+        pLog->ui8LatestValid = pLog->sLatest.ui32FirstSeq >= ui32Oldest && pLog->sLatest.ui32FirstSeq <= ui32Seq;
+        break;
+    }
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerFlashLogLatest (tDATALOG_FLASHLOG *pLog, tDATALOG_FLASHLOG_CAPTURE *pCapture)
+{
+    if (!pLog->ui8LatestValid)
+        return eDATALOG_ERROR_NO_DATA;
+
+    *pCapture = pLog->sLatest;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerFlashLogBegin (tDATALOG_FLASHLOG *pLog)
+{
+    if (!pLog->ui8Mounted || pLog->ui8Open || pLog->ui8Queued || pLog->ui8Programming)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    pLog->ui8Open = 1;
+    pLog->ui32CaptureSeq = pLog->ui32Seq;
+    pLog->ui32CaptureLen = 0;
+    pLog->ui32CapturePages = 0;
+    pLog->ui8FillIdx = pLog->ui8ProgIdx;
+    pLog->ui16FillLen[0] = 0;
+    pLog->ui16FillLen[1] = 0;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerFlashLogWrite (tDATALOG_FLASHLOG *pLog, const uint8_t *pui8Data, uint32_t ui32Len, uint32_t *pui32Done)
+{
+    // The erase block of the next page is erased, the end page is reserved
+    uint32_t ui32MaxPages = pLog->ui32PageCount - pLog->ui32PagesPerBlock;
+    uint32_t ui32Done = 0;
+    tDATALOG_ERROR eError = eDATALOG_ERROR_NONE;
+
+    if (!pLog->ui8Open)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    while (ui32Done < ui32Len && !(pLog->ui8Queued & (1 << pLog->ui8FillIdx)))
+    {
+        uint8_t ui8Idx = pLog->ui8FillIdx;
+        uint32_t ui32Chunk = DATALOGGER_FLASHLOG_PAYLOAD_SIZE - pLog->ui16FillLen[ui8Idx];
+
+        if (!pLog->ui16FillLen[ui8Idx] && pLog->ui32CapturePages + 1 >= ui32MaxPages)
+        {
+            eError = eDATALOG_ERROR_NOT_ENOUGH_MEMORY;
+            break;
+        }
+
+        if (ui32Chunk > ui32Len - ui32Done)
+            ui32Chunk = ui32Len - ui32Done;
+
+        memcpy(&pLog->ui8Page[ui8Idx][DATALOGGER_FLASHLOG_HEADER_SIZE + pLog->ui16FillLen[ui8Idx]], &pui8Data[ui32Done], ui32Chunk);
+        pLog->ui16FillLen[ui8Idx] += (uint16_t)ui32Chunk;
+        pLog->ui32CaptureLen += ui32Chunk;
+        ui32Done += ui32Chunk;
+
+        if (pLog->ui16FillLen[ui8Idx] == DATALOGGER_FLASHLOG_PAYLOAD_SIZE)
+        {
+            _FlashLogQueue(pLog, false);
+
+            eError = DataloggerFlashLogService(pLog);
+
+            if (eError != eDATALOG_ERROR_NONE)
+                break;
+        }
+    }
+
+    if (pui32Done != NULL)
+        *pui32Done = ui32Done;
+
+    return eError;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerFlashLogEnd (tDATALOG_FLASHLOG *pLog)
+{
+    if (!pLog->ui8Open)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    if (pLog->ui8Queued & (1 << pLog->ui8FillIdx))
+        return eDATALOG_ERROR_BUFFER_LOCKED;
+
+    // The end page may be empty if the capture fills its last page exactly
+    _FlashLogQueue(pLog, true);
+    pLog->ui8Open = 0;
+
+    return DataloggerFlashLogService(pLog);
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerFlashLogService (tDATALOG_FLASHLOG *pLog)
+{
+    tDATALOG_ERROR eError;
+
+    while (_FlashLogStep(pLog, &eError))
+        ;
+
+    return eError;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerFlashLogRead (tDATALOG_FLASHLOG *pLog, const tDATALOG_FLASHLOG_CAPTURE *pCapture,
+                                       uint32_t ui32Offset, uint8_t *pui8Data, uint32_t ui32Len)
+{
+    tDATALOG_ERROR eError;
+
+    if (ui32Offset > pCapture->ui32Length || ui32Len > pCapture->ui32Length - ui32Offset)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    while (ui32Len)
+    {
+        uint32_t ui32Seq = pCapture->ui32FirstSeq + ui32Offset / DATALOGGER_FLASHLOG_PAYLOAD_SIZE;
+        uint32_t ui32Pos = ui32Offset % DATALOGGER_FLASHLOG_PAYLOAD_SIZE;
+        uint32_t ui32Chunk = DATALOGGER_FLASHLOG_PAYLOAD_SIZE - ui32Pos;
+
+        if (ui32Chunk > ui32Len)
+            ui32Chunk = ui32Len;
+
+        eError = pLog->pStorage->Read(_FlashLogPageAddr(pLog, ui32Seq) + DATALOGGER_FLASHLOG_HEADER_SIZE + ui32Pos,
+                                      pui8Data, ui32Chunk, pLog->pStorage->pvCtx);
+
+        if (eError != eDATALOG_ERROR_NONE)
+            return eError;
+
+        pui8Data += ui32Chunk;
+        ui32Offset += ui32Chunk;
+        ui32Len -= ui32Chunk;
+    }
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerFlashLogCheck (tDATALOG_FLASHLOG *pLog, const tDATALOG_FLASHLOG_CAPTURE *pCapture)
+{
+    uint8_t ui8Page[DATALOGGER_FLASHLOG_PAGE_SIZE];
+    uint32_t ui32Last = pCapture->ui32FirstSeq + pCapture->ui32Length / DATALOGGER_FLASHLOG_PAYLOAD_SIZE;
+    tDATALOG_ERROR eError;
+
+    // A capture filling its last page exactly ends with an empty page
+    for (uint32_t ui32Seq = pCapture->ui32FirstSeq; ui32Seq <= ui32Last; ui32Seq++)
+    {
+        if (!_FlashLogReadPage(pLog, ui32Seq, ui8Page, &eError))
+            return eError != eDATALOG_ERROR_NONE ? eError : eDATALOG_ERROR_CRC;
+
+        bool bEnd = (ui8Page[14] & DATALOGGER_FLASHLOG_FLAG_END) != 0;
+
+        if (_FlashLogGet32(&ui8Page[8]) != pCapture->ui32FirstSeq || bEnd != (ui32Seq == ui32Last))
+            return eDATALOG_ERROR_CRC;
+    }
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+void DataloggerFlashLogStorage (tDATALOG_FLASHLOG *pLog, const tDATALOG_FLASHLOG_CAPTURE *pCapture, tDATALOG_STORAGE *pView)
+{
+    pLog->sView = *pCapture;
+
+    pView->Write = NULL;
+    pView->Read = _FlashLogViewRead;
+    pView->Erase = NULL;
+    pView->IsBusy = NULL;
+    pView->pvCtx = pLog;
+    pView->ReadAsync = NULL;
+}
+
+// EOF
@@ -0,0 +1,238 @@
+/********************************************************************************//**
+ * \file DataloggerReadout.c
+ * \author Roman Holderried
+ *
+ * \brief Non-blocking readout of captures from the storage backend to an upstream.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *
+ ***********************************************************************************/
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+#include "DataloggerStorage.h"
+#include "DataloggerReadout.h"
+
+/************************************************************************************
+ * Private function definitions
+ ***********************************************************************************/
+static inline bool _ReadoutStorageBusy (tDATALOG_READOUT *pReadout)
+{
+    return pReadout->pStorage->IsBusy != NULL && pReadout->pStorage->IsBusy(pReadout->pStorage->pvCtx);
+}
+
+//===================================================================================
+static inline bool _ReadoutUpstreamBusy (tDATALOG_READOUT *pReadout)
+{
+    return pReadout->pUpstream->IsBusy != NULL && pReadout->pUpstream->IsBusy(pReadout->pUpstream->pvCtx);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Gives up the readout.
+ ***********************************************************************************/
+static tDATALOG_ERROR _ReadoutAbandon (tDATALOG_READOUT *pReadout, tDATALOG_ERROR eError)
+{
+    pReadout->ui8Reading = 0;
+    pReadout->ui8Sending = 0;
+    pReadout->ui8Full = 0;
+    pReadout->eState = eREADOUT_IDLE;
+
+    return eError;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Takes over finished transfers.
+ ***********************************************************************************/
+static void _ReadoutComplete (tDATALOG_READOUT *pReadout)
+{
+    if (pReadout->ui8Reading && !_ReadoutStorageBusy(pReadout))
+    {
+        pReadout->ui8Full |= (1 << pReadout->ui8ReadIdx);
+        pReadout->ui8ReadIdx ^= 1;
+        pReadout->ui8Reading = 0;
+    }
+
+    if (pReadout->ui8Sending && !_ReadoutUpstreamBusy(pReadout))
+    {
+        pReadout->ui8SendIdx ^= 1;
+        pReadout->ui8Sending = 0;
+    }
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Reads the next block if its buffer is free.
+ ***********************************************************************************/
+static tDATALOG_ERROR _ReadoutFetch (tDATALOG_READOUT *pReadout)
+{
+    uint8_t ui8Idx = pReadout->ui8ReadIdx;
+    uint32_t ui32Chunk = pReadout->ui32Remaining;
+    tDATALOG_ERROR eError;
+
+    if (pReadout->ui8Reading || !ui32Chunk || pReadout->ui8Abort)
+        return eDATALOG_ERROR_NONE;
+
+    // Buffer still waiting for (or in) the upstream
+    if ((pReadout->ui8Full & (1 << ui8Idx)) || (pReadout->ui8Sending && pReadout->ui8SendIdx == ui8Idx))
+        return eDATALOG_ERROR_NONE;
+
+    if (_ReadoutStorageBusy(pReadout))
+        return eDATALOG_ERROR_NONE;
+
+    if (ui32Chunk > DATALOGGER_READOUT_CHUNK)
+        ui32Chunk = DATALOGGER_READOUT_CHUNK;
+
+    if (pReadout->pStorage->ReadAsync != NULL)
+    {
+        eError = pReadout->pStorage->ReadAsync(pReadout->ui32Addr, pReadout->ui8Buf[ui8Idx], ui32Chunk, pReadout->pStorage->pvCtx);
+        pReadout->ui8Reading = 1;
+    }
+    else
+    {
+        eError = pReadout->pStorage->Read(pReadout->ui32Addr, pReadout->ui8Buf[ui8Idx], ui32Chunk, pReadout->pStorage->pvCtx);
+        pReadout->ui8Full |= (1 << ui8Idx);
+        pReadout->ui8ReadIdx ^= 1;
+    }
+
+    if (eError != eDATALOG_ERROR_NONE)
+        return eError;
+
+    pReadout->ui32BufLen[ui8Idx] = ui32Chunk;
+    pReadout->ui32Addr += ui32Chunk;
+    pReadout->ui32Remaining -= ui32Chunk;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Hands the next block to the upstream if it is free.
+ ***********************************************************************************/
+static tDATALOG_ERROR _ReadoutSend (tDATALOG_READOUT *pReadout)
+{
+    uint8_t ui8Idx = pReadout->ui8SendIdx;
+    tDATALOG_ERROR eError;
+
+    if (pReadout->ui8Sending || pReadout->ui8Abort || !(pReadout->ui8Full & (1 << ui8Idx)))
+        return eDATALOG_ERROR_NONE;
+
+    eError = pReadout->pUpstream->Send(pReadout->ui8Buf[ui8Idx], pReadout->ui32BufLen[ui8Idx], pReadout->pUpstream->pvCtx);
+
+    if (eError != eDATALOG_ERROR_NONE)
+        return eError;
+
+    pReadout->ui8Full &= ~(1 << ui8Idx);
+    pReadout->ui8Sending = 1;
+    pReadout->ui32Sent += pReadout->ui32BufLen[ui8Idx];
+
+    return eDATALOG_ERROR_NONE;
+}
+
+/************************************************************************************
+ * Function definitions
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerReadoutInit (tDATALOG_READOUT *pReadout, const tDATALOG_STORAGE *pStorage, const tDATALOG_UPSTREAM *pUpstream, 
+                                      uint32_t ui32StorageSize)
+{
+    if (pStorage == NULL || pUpstream == NULL || ui32StorageSize == 0)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    if ((pStorage->Read == NULL && pStorage->ReadAsync == NULL) || pUpstream->Send == NULL)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    // Completion of asynchronous reads is only reported by IsBusy
+    if (pStorage->ReadAsync != NULL && pStorage->IsBusy == NULL)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    memset(pReadout, 0, sizeof(*pReadout));
+    pReadout->pStorage = pStorage;
+    pReadout->pUpstream = pUpstream;
+    pReadout->ui32StorageSize = ui32StorageSize;
+    pReadout->eState = eREADOUT_IDLE;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerReadoutStart (tDATALOG_READOUT *pReadout, uint32_t ui32Addr, uint32_t ui32Len)
+{
+    if (pReadout->eState == eREADOUT_RUNNING)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    if (!ui32Len)
+        return eDATALOG_ERROR_NO_DATA;
+
+    // Written without ui32Addr + ui32Len, which may wrap around
+    if (ui32Addr >= pReadout->ui32StorageSize || ui32Len > pReadout->ui32StorageSize - ui32Addr)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    pReadout->ui32Addr = ui32Addr;
+    pReadout->ui32Remaining = ui32Len;
+    pReadout->ui32Sent = 0;
+    pReadout->ui8ReadIdx = 0;
+    pReadout->ui8SendIdx = 0;
+    pReadout->ui8Reading = 0;
+    pReadout->ui8Sending = 0;
+    pReadout->ui8Full = 0;
+    pReadout->ui8Abort = 0;
+    pReadout->eState = eREADOUT_RUNNING;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerReadoutService (tDATALOG_READOUT *pReadout)
+{
+    tDATALOG_ERROR eError;
+
+    if (pReadout->eState != eREADOUT_RUNNING)
+        return eDATALOG_ERROR_NONE;
+
+    _ReadoutComplete(pReadout);
+
+    if (pReadout->ui8Abort)
+    {
+        if (!pReadout->ui8Reading && !pReadout->ui8Sending)
+            _ReadoutAbandon(pReadout, eDATALOG_ERROR_NONE);
+
+        return eDATALOG_ERROR_NONE;
+    }
+
+    // Read into the free buffer, send the oldest full one. A blocking upstream
+    // frees its buffer right away, it is refilled in the same call.
+    eError = _ReadoutFetch(pReadout);
+
+    if (eError == eDATALOG_ERROR_NONE)
+        eError = _ReadoutSend(pReadout);
+
+    if (eError == eDATALOG_ERROR_NONE)
+    {
+        _ReadoutComplete(pReadout);
+        eError = _ReadoutFetch(pReadout);
+    }
+
+    if (eError != eDATALOG_ERROR_NONE)
+        return _ReadoutAbandon(pReadout, eError);
+
+    if (!pReadout->ui32Remaining && !pReadout->ui8Reading && !pReadout->ui8Sending && !pReadout->ui8Full)
+        pReadout->eState = eREADOUT_DONE;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+void DataloggerReadoutAbort (tDATALOG_READOUT *pReadout)
+{
+    if (pReadout->eState == eREADOUT_RUNNING)
+        pReadout->ui8Abort = 1;
+}
+
+// EOF
@@ -18,6 +18,7 @@
 #include "DataloggerSCI.h"
 #include "DataloggerCfg.h"
 #include "Datalogger.h"
+#include "DataloggerReadout.h"
 #include "SCI.h"
 
 #ifdef SCI
@@ -31,6 +32,7 @@
  ***********************************************************************************/
 extern const uint8_t ui8_byteLength[];
 extern tDATALOGGER sDatalogger[];
+extern tDATALOG_READOUT sDataloggerReadout[];
 uint32_t ui32ReturnValBuffer[SIZE_OF_RETURN_VAL_BUFFER];
 
 /************************************************************************************
@@ -159,6 +161,38 @@ COMMAND_CB_STATUS GetLogData (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PR
     }
 }
 
+//=============================================================================
+COMMAND_CB_STATUS GetMemoryData (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PROCESS_INFO *pInfo)
+{
+    uint8_t ui8Index = (uint8_t)ui32ValArray[0];
+    tDATALOGGER *psDatalog = &sDatalogger[ui8Index];
+    tDATALOG_ERROR eDlogError = eDATALOG_ERROR_NONE;
+    uint32_t ui32Addr = 0;
+    uint32_t ui32Len = psDatalog->sMemoryHeader.ui32LastAddress + 1;
+
+    // Optional storage region (checked against the storage size by the readout), 
+    // the capture of the memory op mode otherwise. RAM captures are not in the 
+    // storage, they are read with GetLogData.
+    if (ui8ValArrayLen > 2)
+    {
+        ui32Addr = ui32ValArray[1];
+        ui32Len = ui32ValArray[2];
+    }
+    else if (psDatalog->sDatalogControl.eOpMode != eOPMODE_RECMODEMEM)
+        eDlogError = eDATALOG_ERROR_NO_DATA;
+
+    if (eDlogError == eDATALOG_ERROR_NONE)
+        eDlogError = DataloggerReadoutStart(&sDataloggerReadout[ui8Index], ui32Addr, ui32Len);
+    
+    if (eDlogError == eDATALOG_ERROR_NONE)
+        return eCOMMAND_STATUS_SUCCESS;
+    else
+    {
+        pInfo->ui16_error = DATALOGGER_SCI_ERROR((uint16_t)eDlogError);
+        return eCOMMAND_STATUS_ERROR;
+    }
+}
+
 //=============================================================================
 COMMAND_CB_STATUS GetChannelInfo (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PROCESS_INFO *pInfo)
 {
@@ -173,11 +207,43 @@ COMMAND_CB_STATUS GetChannelInfo (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen
     
     if (eDlogError == eDATALOG_ERROR_NONE)
     {
+        // Divider of the capture, runtime changes are read with GetRateMarker
+        DataloggerGetCaptureDivider(&sDatalogger[ui8Index], ui8ChNum, &sChInfo.ui16Divider);
+
         ui32ReturnValBuffer[0] = sChInfo.ui32ChID;
         ui32ReturnValBuffer[1] = sChInfo.ui16Divider;
         ui32ReturnValBuffer[2] = sChInfo.ui32RecordLength;
         ui32ReturnValBuffer[3] = sChInfo.ui32CurrentCount;
         ui32ReturnValBuffer[4] = sChInfo.ui32MemoryOffset;
+        ui32ReturnValBuffer[5] = (uint32_t)DataloggerGetChannelKind(&sChInfo);
+        pInfo->pui32_dataBuf = ui32ReturnValBuffer;
+        pInfo->ui32_datLen = 6;
+
+        return eCOMMAND_STATUS_SUCCESS_DATA;
+    }
+    else
+    {
+        pInfo->ui16_error = DATALOGGER_SCI_ERROR((uint16_t)eDlogError);
+        return eCOMMAND_STATUS_ERROR;
+    }
+}
+
+//=============================================================================
+COMMAND_CB_STATUS GetRateMarker (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PROCESS_INFO *pInfo)
+{
+    uint8_t ui8Index = (uint8_t)ui32ValArray[0];
+    uint16_t ui16MarkerNum = (uint16_t)ui32ValArray[1];
+    tDATALOG_RATE_MARKER sMarker;
+
+    tDATALOG_ERROR eDlogError = DataloggerGetRateMarker(&sDatalogger[ui8Index], &sMarker, ui16MarkerNum);
+    
+    if (eDlogError == eDATALOG_ERROR_NONE)
+    {
+        ui32ReturnValBuffer[0] = sMarker.ui8LogNum;
+        ui32ReturnValBuffer[1] = sMarker.ui16OldDivider;
+        ui32ReturnValBuffer[2] = sMarker.ui16Divider;
+        ui32ReturnValBuffer[3] = sMarker.ui32SampleIdx;
+        ui32ReturnValBuffer[4] = sMarker.ui32Tick;
         pInfo->pui32_dataBuf = ui32ReturnValBuffer;
         pInfo->ui32_datLen = 5;
 
@@ -245,5 +311,60 @@ COMMAND_CB_STATUS SetOpMode (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PRO
         return eCOMMAND_STATUS_ERROR;
     }
 }
+
+//=============================================================================
+COMMAND_CB_STATUS GetMemoryBudget (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PROCESS_INFO *pInfo)
+{
+    uint8_t ui8Index = (uint8_t)ui32ValArray[0];
+    tDATALOG_BUDGET sBudget;
+
+    tDATALOG_ERROR eDlogError = DataloggerGetBudget(&sDatalogger[ui8Index], &sBudget);
+    
+    if (eDlogError == eDATALOG_ERROR_NONE)
+    {
+        ui32ReturnValBuffer[0] = sBudget.ui32Capacity;
+        ui32ReturnValBuffer[1] = sBudget.ui32Required;
+        ui32ReturnValBuffer[2] = (uint32_t)sBudget.i32Remaining;
+        pInfo->pui32_dataBuf = ui32ReturnValBuffer;
+        pInfo->ui32_datLen = 3;
+
+        return eCOMMAND_STATUS_SUCCESS_DATA;
+    }
+    else
+    {
+        pInfo->ui16_error = DATALOGGER_SCI_ERROR((uint16_t)eDlogError);
+        return eCOMMAND_STATUS_ERROR;
+    }
+}
+
+//=============================================================================
+COMMAND_CB_STATUS AutoSizeRecordLengths (uint32_t* ui32ValArray, uint8_t ui8ValArrayLen, PROCESS_INFO *pInfo)
+{
+    uint8_t ui8Index = (uint8_t)ui32ValArray[0];
+    tDATALOG_SIZING eMode = (tDATALOG_SIZING)ui32ValArray[1];
+    uint8_t ui8Weights[MAX_NUM_LOGS] = {0};
+    const uint8_t *pui8Weights = NULL;
+
+    // Optional weights of channel 1 - MAX_NUM_LOGS
+    if (ui8ValArrayLen > 2)
+    {
+        for (uint8_t i = 0; i < MAX_NUM_LOGS && (i + 2) < ui8ValArrayLen; i++)
+            ui8Weights[i] = (uint8_t)ui32ValArray[i + 2];
+
+        pui8Weights = ui8Weights;
+    }
+
+    tDATALOG_ERROR eDlogError = DataloggerAutoSize(&sDatalogger[ui8Index], eMode, pui8Weights);
+    
+    if (eDlogError == eDATALOG_ERROR_NONE)
+    {
+        return eCOMMAND_STATUS_SUCCESS;
+    }
+    else
+    {
+        pInfo->ui16_error = DATALOGGER_SCI_ERROR((uint16_t)eDlogError);
+        return eCOMMAND_STATUS_ERROR;
+    }
+}
 #endif
 // EOF
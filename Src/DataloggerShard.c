@@ -0,0 +1,295 @@
+/********************************************************************************//**
+ * \file DataloggerShard.c
+ * \author Roman Holderried
+ *
+ * \brief Per-core datalogger shards with a tick ordered merge.
+ *
+ * Every core owns a complete tDATALOGGER instance (shard) and only records its 
+ * own channels, so sampling needs no cross-core locking. At readout, the 
+ * captures of all shards are interleaved by service tick.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+#include "DataloggerShard.h"
+
+/************************************************************************************
+ * Function definitions
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerShardInit (tDATALOG_SHARD_SET *pSet, tDATALOGGER *psShards, uint8_t ui8ShardCount, 
+                                    tDATALOGGER *psConfig, const uint8_t *pui8ChannelShard)
+{
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_ERROR eError;
+    uint8_t s, i;
+
+    if (ui8ShardCount == 0 || ui8ShardCount > DATALOGGER_MAX_SHARDS)
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    for (i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        if ((psConfig->sDatalogControl.ui8ActiveLoggers & (1 << i)) && pui8ChannelShard[i] >= ui8ShardCount)
+            return eDATALOG_ERROR_INVALID_PARAMETER;
+    }
+
+    // Back to the defaults, releases the buffers of an earlier configuration.
+    // Running or locked shards are refused.
+    for (s = 0; s < ui8ShardCount; s++)
+    {
+        eError = DataloggerReset(&psShards[s]);
+
+        if (eError != eDATALOG_ERROR_NONE)
+            return eError;
+    }
+
+    pSet->psShards = psShards;
+    pSet->ui8ShardCount = ui8ShardCount;
+    pSet->ui8Merging = 0;
+
+    for (i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        pSet->ui8ChannelShard[i] = 0;
+        pSet->ui32MergeIdx[i] = 0;
+    }
+
+    for (s = 0; s < DATALOGGER_MAX_SHARDS; s++)
+        pSet->ui8MergeLocks[s] = 0;
+
+    for (s = 0; s < ui8ShardCount; s++)
+    {
+        DataloggerInit(&psShards[s], sCallbacks);
+        psShards[s].sNVPar = psConfig->sNVPar;
+
+        eError = DataloggerSetOpMode(&psShards[s], psConfig->sDatalogControl.eOpMode);
+
+        // The gather hook is called by every shard with its own descriptor table
+        if (eError == eDATALOG_ERROR_NONE)
+            eError = DataloggerSetGather(&psShards[s], psConfig->sGather.pfnGather, psConfig->sGather.pvCtx);
+
+        if (eError == eDATALOG_ERROR_NONE)
+            eError = DataloggerSetSequence(&psShards[s], psConfig->sSequence.ui16SegmentCount, psConfig->sSequence.eRearmMode);
+
+        if (eError != eDATALOG_ERROR_NONE)
+            return eError;
+
+        for (uint8_t k = 1; k < DATALOGGER_MAX_TIMEBASES; k++)
+            psShards[s].sTimebases.ui16Ratio[k] = psConfig->sTimebases.ui16Ratio[k];
+    }
+
+    // Every shard gets a copy of its channels, log numbers are kept
+    for (i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        tDATALOG_CHANNEL *pChannel = &psConfig->sDatalogControl.sDatalogChannels[i];
+        tDATALOGGER *psShard;
+
+        if (!(psConfig->sDatalogControl.ui8ActiveLoggers & (1 << i)))
+            continue;
+
+        pSet->ui8ChannelShard[i] = pui8ChannelShard[i];
+        psShard = &psShards[pui8ChannelShard[i]];
+
+        if (pChannel->pfnGetter != NULL)
+            eError = DataloggerRegisterGetterLog(psShard, pChannel->ui32ChID, i + 1, pChannel->ui16Divider, pChannel->ui32RecordLength, 
+                                                 pChannel->pfnGetter, pChannel->pvGetterCtx, pChannel->ui8ByteCount);
+        else if (pChannel->ui8HistByteCount)
+            eError = DataloggerRegisterHistogramLog(psShard, pChannel->ui32ChID, i + 1, pChannel->ui16Divider, pChannel->ui32RecordLength, 
+                                                    pChannel->pui8Variable, pChannel->ui8HistByteCount, pChannel->ui8HistSigned != 0, 
+                                                    pChannel->i32HistMin, pChannel->ui8HistShift);
+        else if (pChannel->ui32BitMask)
+            eError = DataloggerRegisterBitLog(psShard, pChannel->ui32ChID, i + 1, pChannel->ui16Divider, pChannel->ui32RecordLength, 
+                                              pChannel->pui8Variable, pChannel->ui8ByteCount, pChannel->ui32BitMask);
+        else
+            eError = DataloggerRegisterLog(psShard, pChannel->ui32ChID, i + 1, pChannel->ui16Divider, pChannel->ui32RecordLength, 
+                                           pChannel->pui8Variable, pChannel->ui8ByteCount);
+
+        if (eError == eDATALOG_ERROR_NONE)
+            eError = DataloggerSetChannelScaling(psShard, i + 1, pChannel->sScaling);
+
+        if (eError == eDATALOG_ERROR_NONE && pChannel->pui32Guard != NULL)
+            eError = DataloggerSetChannelGuard(psShard, i + 1, pChannel->pui32Guard);
+
+        if (eError == eDATALOG_ERROR_NONE && pChannel->ui8CicOrder)
+            eError = DataloggerSetChannelDecimation(psShard, i + 1, pChannel->ui8CicOrder);
+
+        for (uint8_t k = 1; k < DATALOGGER_MAX_TIMEBASES; k++)
+        {
+            if (eError == eDATALOG_ERROR_NONE && (psConfig->sTimebases.ui8Channels[k] & (1 << i)))
+                eError = DataloggerSetChannelTimebase(psShard, i + 1, k);
+        }
+
+        if (eError != eDATALOG_ERROR_NONE)
+            return eError;
+    }
+
+    for (s = 0; s < ui8ShardCount; s++)
+    {
+        // Shards without channels stay uninitialized
+        if (!psShards[s].sDatalogControl.ui8ActiveLoggers)
+            continue;
+
+        eError = DataloggerInitLogger(&psShards[s], true);
+
+        if (eError != eDATALOG_ERROR_NONE)
+            return eError;
+    }
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerShardStart (tDATALOG_SHARD_SET *pSet)
+{
+    tDATALOG_ERROR eError;
+
+    if (pSet->ui8Merging)
+        return eDATALOG_ERROR_BUFFER_LOCKED;
+
+    for (uint8_t s = 0; s < pSet->ui8ShardCount; s++)
+    {
+        if (!pSet->psShards[s].sDatalogControl.ui8ActiveLoggers)
+            continue;
+
+        eError = DataloggerStart(&pSet->psShards[s]);
+
+        if (eError != eDATALOG_ERROR_NONE)
+        {
+            DataloggerShardStop(pSet);
+            return eError;
+        }
+    }
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+void DataloggerShardStop (tDATALOG_SHARD_SET *pSet)
+{
+    for (uint8_t s = 0; s < pSet->ui8ShardCount; s++)
+    {
+        if (pSet->psShards[s].eDatalogState == eDLOGSTATE_RUNNING)
+            DataloggerStop(&pSet->psShards[s]);
+    }
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerShardMergeBegin (tDATALOG_SHARD_SET *pSet)
+{
+    tDATALOG_ERROR eError;
+    uint8_t s;
+
+    if (pSet->ui8Merging)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    for (s = 0; s < pSet->ui8ShardCount; s++)
+    {
+        if (!pSet->psShards[s].sDatalogControl.ui8ActiveLoggers)
+            continue;
+
+        eError = DataloggerLockReadout(&pSet->psShards[s], &pSet->ui8MergeLocks[s]);
+
+        if (eError != eDATALOG_ERROR_NONE)
+        {
+            // Release the shards locked so far
+            while (s--)
+            {
+                if (pSet->psShards[s].sDatalogControl.ui8ActiveLoggers)
+                    DataloggerUnlockReadout(&pSet->psShards[s], pSet->ui8MergeLocks[s]);
+            }
+
+            return eError;
+        }
+    }
+
+    for (uint8_t i = 0; i < MAX_NUM_LOGS; i++)
+        pSet->ui32MergeIdx[i] = 0;
+
+    pSet->ui8Merging = 1;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+tDATALOG_ERROR DataloggerShardMerge (tDATALOG_SHARD_SET *pSet, tDATALOG_SHARD_SAMPLE *pDst, uint32_t ui32MaxCount, uint32_t *pui32Count)
+{
+    tDATALOG_CHANNEL_VIEW sViews[MAX_NUM_LOGS];
+    uint8_t ui8Channels = 0;
+    uint32_t ui32Count = 0;
+    uint8_t i;
+
+    *pui32Count = 0;
+
+    if (!pSet->ui8Merging)
+        return eDATALOG_ERROR_WRONG_STATE;
+
+    for (i = 0; i < MAX_NUM_LOGS; i++)
+    {
+        tDATALOGGER *psShard = &pSet->psShards[pSet->ui8ChannelShard[i]];
+
+        if (DataloggerGetChannelView(psShard, &sViews[i], i + 1) == eDATALOG_ERROR_NONE)
+            ui8Channels |= (1 << i);
+    }
+
+    while (ui32Count < ui32MaxCount)
+    {
+        uint32_t ui32MinTick = 0;
+        uint32_t ui32Tick;
+        uint8_t ui8Min = MAX_NUM_LOGS;
+
+        // Channel with the earliest pending sample, lowest log number first
+        for (i = 0; i < MAX_NUM_LOGS; i++)
+        {
+            if (!(ui8Channels & (1 << i)) || pSet->ui32MergeIdx[i] >= sViews[i].ui32Count)
+                continue;
+
+            if (DataloggerGetSampleTick(&pSet->psShards[pSet->ui8ChannelShard[i]], i + 1, pSet->ui32MergeIdx[i], &ui32Tick) != eDATALOG_ERROR_NONE)
+                continue;
+
+            if (ui8Min == MAX_NUM_LOGS || ui32Tick < ui32MinTick)
+            {
+                ui8Min = i;
+                ui32MinTick = ui32Tick;
+            }
+        }
+
+        if (ui8Min == MAX_NUM_LOGS)
+            break;
+
+        pDst[ui32Count].ui32Tick = ui32MinTick;
+        pDst[ui32Count].ui8LogNum = ui8Min + 1;
+        pDst[ui32Count].ui8Shard = pSet->ui8ChannelShard[ui8Min];
+        pDst[ui32Count].ui64Value = DataloggerViewGetSample(&sViews[ui8Min], pSet->ui32MergeIdx[ui8Min]);
+
+        pSet->ui32MergeIdx[ui8Min]++;
+        ui32Count++;
+    }
+
+    *pui32Count = ui32Count;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+void DataloggerShardMergeEnd (tDATALOG_SHARD_SET *pSet)
+{
+    if (!pSet->ui8Merging)
+        return;
+
+    for (uint8_t s = 0; s < pSet->ui8ShardCount; s++)
+    {
+        if (pSet->psShards[s].sDatalogControl.ui8ActiveLoggers)
+            DataloggerUnlockReadout(&pSet->psShards[s], pSet->ui8MergeLocks[s]);
+    }
+
+    pSet->ui8Merging = 0;
+}
+// EOF
@@ -0,0 +1,141 @@
+/********************************************************************************//**
+ * \file DataloggerStatic.c
+ * \author Roman Holderried
+ *
+ * \brief Service routine generated from the static channel configuration.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+#include "DataloggerStatic.h"
+
+#ifdef DATALOGGER_STATIC_CHANNELS
+
+#ifdef DATALOGGER_STATIC_CHANNELS_HEADER
+#include DATALOGGER_STATIC_CHANNELS_HEADER
+#endif
+
+/************************************************************************************
+ * Defines
+ ***********************************************************************************/
+/** Layout of the capture buffer, the member offsets are the channel offsets */
+#define STATIC_LAYOUT_MEMBER(ChID, LogNum, Divider, RecLen, Variable) \
+    uint8_t ch##LogNum[(RecLen) * sizeof(Variable)];
+
+typedef struct
+{
+    DATALOGGER_STATIC_CHANNELS(STATIC_LAYOUT_MEMBER)
+}tDATALOG_STATIC_LAYOUT;
+
+// Compile time checks of the configuration
+#define STATIC_CHECK_CHANNEL(ChID, LogNum, Divider, RecLen, Variable) \
+    typedef char _StaticCheckCh##LogNum[((LogNum) >= 1 && (LogNum) <= MAX_NUM_LOGS && \
+                                         sizeof(Variable) <= 8 && (Divider) >= 1) ? 1 : -1];
+
+DATALOGGER_STATIC_CHANNELS(STATIC_CHECK_CHANNEL)
+typedef char _StaticCheckSize[(sizeof(tDATALOG_STATIC_LAYOUT) <= DATALOGGER_MAX_BUFFER_SIZE) ? 1 : -1];
+
+/************************************************************************************
+ * Private function definitions
+ ***********************************************************************************/
+/********************************************************************************//**
+ * \brief Stores a variable in big endian format. Unrolled for constant widths.
+ ***********************************************************************************/
+static inline void _StoreBigEndian (uint8_t *pui8Dst, const uint8_t *pui8Src, uint8_t ui8ByteCount)
+{
+    for (uint8_t j = 0; j < ui8ByteCount; j++)
+        pui8Dst[j] = pui8Src[ui8ByteCount - 1 - j];
+}
+
+/************************************************************************************
+ * Function definitions
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerStaticInit (tDATALOGGER *psDatalog)
+{
+    tDATALOG_ERROR eError = eDATALOG_ERROR_NONE;
+
+    // The static service always stores big endian samples into the capture buffer
+    if (psDatalog->sGather.pfnGather != NULL || psDatalog->sDatalogControl.eOpMode != eOPMODE_RECMODERAM)
+        return eDATALOG_ERROR_NOT_IMPLEMENTED;
+
+#define STATIC_REGISTER(ChID, LogNum, Divider, RecLen, Variable) \
+    if (eError == eDATALOG_ERROR_NONE) \
+        eError = DataloggerRegisterLog(psDatalog, (ChID), (LogNum), (Divider), (RecLen), (uint8_t*)&(Variable), sizeof(Variable));
+
+    DATALOGGER_STATIC_CHANNELS(STATIC_REGISTER)
+
+    // Further channels (bit, getter, guarded ...) would not be sampled
+#define STATIC_MASK(ChID, LogNum, Divider, RecLen, Variable) | (1 << ((LogNum) - 1))
+
+    if (eError == eDATALOG_ERROR_NONE && psDatalog->sDatalogControl.ui8ActiveLoggers != (0 DATALOGGER_STATIC_CHANNELS(STATIC_MASK)))
+        eError = eDATALOG_ERROR_INVALID_PARAMETER;
+
+    if (eError == eDATALOG_ERROR_NONE)
+        eError = DataloggerInitLogger(psDatalog, true);
+
+    if (eError != eDATALOG_ERROR_NONE)
+        return eError;
+
+    // The dynamic layout must match the compile time layout. This fails if the
+    // entries are not ordered or further channels have been registered.
+#define STATIC_CHECK_OFFSET(ChID, LogNum, Divider, RecLen, Variable) \
+    if (psDatalog->sDatalogControl.sDatalogChannels[(LogNum) - 1].ui32MemoryOffset != offsetof(tDATALOG_STATIC_LAYOUT, ch##LogNum)) \
+        eError = eDATALOG_ERROR_INVALID_PARAMETER;
+
+    DATALOGGER_STATIC_CHANNELS(STATIC_CHECK_OFFSET)
+
+    return eError;
+}
+
+//===================================================================================
+void DataloggerStaticService (tDATALOGGER *psDatalog)
+{
+    tDATALOG_CHANNEL *pChannel = psDatalog->sDatalogControl.sDatalogChannels;
+    uint8_t *pui8Data = psDatalog->sDatalogControl.pui8Data;
+#if DATALOGGER_CRC_BLOCK_SIZE
+    tDATALOG_SEGMENT_TABLE *pTable = &psDatalog->sSequence.sTables[psDatalog->sDatalogControl.ui8CaptureBufIdx];
+
+#define STATIC_CRC(LogNum, Variable) \
+        if (pTable->ui8CrcChannels & (1 << ((LogNum) - 1))) \
+            _DataloggerCrcAppend(pTable, &pChannel[(LogNum) - 1], &pui8Data[offsetof(tDATALOG_STATIC_LAYOUT, ch##LogNum) + \
+                                 pChannel[(LogNum) - 1].ui32CurrentCount * sizeof(Variable)], sizeof(Variable));
+#else
+#define STATIC_CRC(LogNum, Variable)
+#endif
+
+    if (!_DataloggerServiceBegin(psDatalog))
+        return;
+
+    // The divider is reloaded from the channel, DataloggerSetChannelDivider may 
+    // have changed it at runtime
+#define STATIC_SAMPLE(ChID, LogNum, Divider, RecLen, Variable) \
+    if ((psDatalog->sDatalogControl.ui8ChannelsRunning & (1 << ((LogNum) - 1))) && \
+        !(--pChannel[(LogNum) - 1].ui16DivideCount)) \
+    { \
+        _StoreBigEndian(&pui8Data[offsetof(tDATALOG_STATIC_LAYOUT, ch##LogNum) + \
+                                  pChannel[(LogNum) - 1].ui32CurrentCount * sizeof(Variable)], \
+                        (const uint8_t*)&(Variable), sizeof(Variable)); \
+        STATIC_CRC(LogNum, Variable) \
+        DATALOGGER_ATOMIC_STORE32(&pChannel[(LogNum) - 1].ui32CommittedCount, ++pChannel[(LogNum) - 1].ui32CurrentCount); \
+        if (pChannel[(LogNum) - 1].ui32CurrentCount == pChannel[(LogNum) - 1].ui32SegmentEnd) \
+            DATALOGGER_ATOMIC_CLEAR8(&psDatalog->sDatalogControl.ui8ChannelsRunning, 1 << ((LogNum) - 1)); \
+        pChannel[(LogNum) - 1].ui16DivideCount = pChannel[(LogNum) - 1].ui16Divider; \
+    }
+
+    DATALOGGER_STATIC_CHANNELS(STATIC_SAMPLE)
+
+    _DataloggerServiceEnd(psDatalog);
+}
+
+#endif
+// EOF
@@ -0,0 +1,164 @@
+/********************************************************************************//**
+ * \file DataloggerStorageFile.c
+ * \author Roman Holderried
+ *
+ * \brief File backed storage for host builds.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+#if !defined(_POSIX_C_SOURCE) && !defined(_DEFAULT_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+#include "DataloggerStorage.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/************************************************************************************
+ * Private function definitions
+ ***********************************************************************************/
+static bool _StorageFileInRange (tDATALOG_STORAGE_FILE *pFile, uint32_t ui32Addr, uint32_t ui32Len)
+{
+    return ui32Addr <= pFile->ui32Size && ui32Len <= pFile->ui32Size - ui32Addr;
+}
+
+//===================================================================================
+static tDATALOG_ERROR _StorageFileWrite (uint32_t ui32Addr, const uint8_t *pui8Data, uint32_t ui32Len, void *pvCtx)
+{
+    tDATALOG_STORAGE_FILE *pFile = (tDATALOG_STORAGE_FILE*)pvCtx;
+
+    if (!_StorageFileInRange(pFile, ui32Addr, ui32Len))
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    while (ui32Len > 0)
+    {
+        ssize_t sWritten = pwrite(pFile->iFd, pui8Data, ui32Len, (off_t)ui32Addr);
+
+        if (sWritten < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return eDATALOG_ERROR_IO;
+        }
+
+        pui8Data += sWritten;
+        ui32Addr += (uint32_t)sWritten;
+        ui32Len -= (uint32_t)sWritten;
+    }
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+static tDATALOG_ERROR _StorageFileRead (uint32_t ui32Addr, uint8_t *pui8Data, uint32_t ui32Len, void *pvCtx)
+{
+    tDATALOG_STORAGE_FILE *pFile = (tDATALOG_STORAGE_FILE*)pvCtx;
+
+    if (!_StorageFileInRange(pFile, ui32Addr, ui32Len))
+        return eDATALOG_ERROR_INVALID_PARAMETER;
+
+    while (ui32Len > 0)
+    {
+        ssize_t sRead = pread(pFile->iFd, pui8Data, ui32Len, (off_t)ui32Addr);
+
+        if (sRead < 0 && errno == EINTR)
+            continue;
+
+        if (sRead <= 0)
+            return eDATALOG_ERROR_IO;
+
+        pui8Data += sRead;
+        ui32Addr += (uint32_t)sRead;
+        ui32Len -= (uint32_t)sRead;
+    }
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+static tDATALOG_ERROR _StorageFileErase (uint32_t ui32Addr, uint32_t ui32Len, void *pvCtx)
+{
+    uint8_t ui8Erased[256];
+    tDATALOG_ERROR eError = eDATALOG_ERROR_NONE;
+
+    memset(ui8Erased, 0xFF, sizeof(ui8Erased));
+
+    while (ui32Len > 0 && eError == eDATALOG_ERROR_NONE)
+    {
+        uint32_t ui32Chunk = ui32Len < sizeof(ui8Erased) ? ui32Len : sizeof(ui8Erased);
+
+        eError = _StorageFileWrite(ui32Addr, ui8Erased, ui32Chunk, pvCtx);
+        ui32Addr += ui32Chunk;
+        ui32Len -= ui32Chunk;
+    }
+
+    return eError;
+}
+
+/************************************************************************************
+ * Function definitions
+ ***********************************************************************************/
+tDATALOG_ERROR DataloggerStorageFileOpen (tDATALOG_STORAGE *pStorage, tDATALOG_STORAGE_FILE *pFile, const char *pcPath, uint32_t ui32Size)
+{
+    struct stat sStat;
+    tDATALOG_ERROR eError = eDATALOG_ERROR_NONE;
+
+    pFile->iFd = open(pcPath, O_RDWR | O_CREAT, 0644);
+
+    if (pFile->iFd < 0)
+        return eDATALOG_ERROR_IO;
+
+    if (fstat(pFile->iFd, &sStat) != 0)
+    {
+        DataloggerStorageFileClose(pFile);
+        return eDATALOG_ERROR_IO;
+    }
+
+    pFile->ui32Size = ui32Size;
+
+    // Missing part of the file reads as erased memory
+    if ((uint64_t)sStat.st_size < ui32Size)
+        eError = _StorageFileErase((uint32_t)sStat.st_size, ui32Size - (uint32_t)sStat.st_size, pFile);
+
+    if (eError != eDATALOG_ERROR_NONE)
+    {
+        DataloggerStorageFileClose(pFile);
+        return eError;
+    }
+
+    pStorage->Write = _StorageFileWrite;
+    pStorage->Read = _StorageFileRead;
+    pStorage->Erase = _StorageFileErase;
+    pStorage->IsBusy = NULL;
+    pStorage->pvCtx = pFile;
+    pStorage->ReadAsync = NULL;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+void DataloggerStorageFileClose (tDATALOG_STORAGE_FILE *pFile)
+{
+    if (pFile->iFd >= 0)
+        close(pFile->iFd);
+
+    pFile->iFd = -1;
+}
+
+#endif
+// EOF
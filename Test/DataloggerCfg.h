@@ -0,0 +1,81 @@
+/********************************************************************************//**
+ * \file DataloggerCfg.h
+ * \author Roman Holderried
+ *
+ * \brief Configuration of the behaviour tests (DataloggerTest.c).
+ *
+ * Same as the template, except for A/B buffering and consistent reads, which 
+ * the tests cover.
+ *
+ * <b> History </b>
+ *      - 2026-10-19: File creation.
+ *                     
+ ***********************************************************************************/
+
+#ifndef _DATALOGGERCFG_H_
+#define _DATALOGGERCFG_H_
+
+/******************************************************************************
+ * Configuration Macros
+ *****************************************************************************/
+/** Maximum buffer size the datalogger can write */
+#define DATALOGGER_MAX_BUFFER_SIZE 2048
+/** Number of RECMODERAM capture buffers (1: single buffer, 2: A/B buffering). 
+ *  Each buffer takes up to DATALOGGER_MAX_BUFFER_SIZE bytes, so 2 doubles the RAM 
+ *  requirement. */
+#define DATALOGGER_CAPTURE_BUFFERS 2
+/** Maximum number of segments per start in sequence mode */
+#define DATALOGGER_MAX_SEGMENTS 16
+/** Consistent sampling of variables written by other contexts (0: bytewise copy).
+ *  Aligned variables up to DATALOGGER_ATOMIC_LOAD_SIZE bytes are read with a 
+ *  single load, guarded variables by the sequence counter protocol. */
+#define DATALOGGER_CONSISTENT_READ 1
+/** Widest single-access load of the target (4: 32 bit core, 8: 64 bit core) */
+#define DATALOGGER_ATOMIC_LOAD_SIZE 4
+/** Read attempts of a guarded variable before the last sample is repeated */
+#define DATALOGGER_GUARD_RETRIES 4
+/** Critical section of the read-modify-writes shared by services which may 
+ *  preempt each other (timebases). Replaces the GCC atomic builtins, required on
+ *  targets without exclusive accesses (e.g. Cortex-M0, where the builtins become
+ *  libatomic calls) and on other compilers. ENTER may declare a local variable. */
+// #define DATALOGGER_CRITICAL_ENTER()  uint32_t ui32Primask = __get_PRIMASK(); __disable_irq()
+// #define DATALOGGER_CRITICAL_EXIT()   __set_PRIMASK(ui32Primask)
+/** Maximum number of per-core shards of a shard set */
+#define DATALOGGER_MAX_SHARDS 4
+/** Number of timebases (service entry points) of a datalogger, 1 - 8 */
+#define DATALOGGER_MAX_TIMEBASES 2
+/** Maximum number of runtime divider changes and channel stops per capture.
+ *  Ring captures use one marker per channel, so MAX_NUM_LOGS are recommended. */
+#define DATALOGGER_MAX_MARKERS 8
+/** Maximum order of the CIC decimation filters (2 * 8 bytes of state per order and channel) */
+#define DATALOGGER_CIC_MAX_ORDER 3
+/** Bytes per CRC-32 block of RAM captures (0: no block CRCs) */
+#define DATALOGGER_CRC_BLOCK_SIZE 256
+/** CRC-32 implementation: 1 slice-by-8 (8 KB tables), 0 nibble table (64 bytes).
+ *  Defaults to slice-by-8 on host builds only. */
+// #define DATALOGGER_CRC_SLICE_BY_8 0
+/** Bytes per storage write of the black box (also the read buffer of the recovery) */
+#define DATALOGGER_BLACKBOX_CHUNK 256
+/** Bytes per block of the streaming readout (two blocks are buffered) */
+#define DATALOGGER_READOUT_CHUNK 256
+/** Program page size of the flash log (two page buffers are kept) */
+#define DATALOGGER_FLASHLOG_PAGE_SIZE 256
+
+/******************************************************************************
+ * Static channel configuration (optional)
+ *****************************************************************************/
+/** Channels known at build time. DataloggerStaticService samples them with 
+ *  constant offsets, widths and dividers. Entries are given as
+ *  X(ChID, LogNum, Divider, RecLen, Variable) in ascending log number order. */
+/*
+#define DATALOGGER_STATIC_CHANNELS(X) \
+    X(1, 1, 1,  256, ui16PhaseCurrent) \
+    X(2, 2, 10, 64,  i32Speed)
+*/
+/** Header declaring the variables of the static channels */
+// #define DATALOGGER_STATIC_CHANNELS_HEADER "AppVariables.h"
+/** Returned error indicators will be offset by this value*/
+#define DATALOGGER_SCI_ERROR_OFFSET 10
+
+
+#endif // _DATALOGGERCFG_H_
@@ -0,0 +1,1606 @@
+/********************************************************************************//**
+ * \file DataloggerTest.c
+ * \author Roman Holderried
+ *
+ * \brief Behaviour tests of the datalogger (host build).
+ *
+ * Uses the test configuration next to this file, build from the repository root:
+ *
+ *  gcc -std=c99 -ITest -IInc -IInc/config Test/DataloggerTest.c Src/Datalogger.c 
+ *      Src/DataloggerCrc.c Src/DataloggerReadout.c Src/DataloggerFlashLog.c 
+ *      Src/DataloggerExport.c Src/DataloggerConvert.c Src/DataloggerBlackBox.c 
+ *      Src/DataloggerStorageFile.c Src/DataloggerShard.c -o DataloggerTest
+ *
+ * Returns 0 if all checks passed.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+#if !defined(_POSIX_C_SOURCE) && !defined(_DEFAULT_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/************************************************************************************
+ * Includes
+ ***********************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "DataloggerCfg.h"
+#include "Datalogger.h"
+#include "DataloggerCrc.h"
+#include "DataloggerReadout.h"
+#include "DataloggerFlashLog.h"
+#include "DataloggerConvert.h"
+#include "DataloggerBlackBox.h"
+#include "DataloggerShard.h"
+#include "DataloggerExport.h"
+#include "UnitTest.h"
+
+/************************************************************************************
+ * Global variables
+ ***********************************************************************************/
+uint32_t ui32UnitTestFailures = 0;
+
+static uint32_t ui32GatherCalls = 0;
+static uint8_t ui8GatherMaxCount = 0;
+
+// Storage and upstream of the readout test
+static uint8_t ui8Storage[1000];
+static uint8_t ui8Received[1000];
+static uint32_t ui32ReceivedLen = 0;
+static uint8_t ui8ReadBusy = 0;
+
+// NOR flash of the flash log test: 4 erase blocks, programming clears bits
+#define TEST_FLASH_BLOCK_SIZE   1024
+#define TEST_FLASH_BLOCKS       4
+static uint8_t ui8Flash[TEST_FLASH_BLOCK_SIZE * TEST_FLASH_BLOCKS];
+static uint8_t ui8Payload[2000];
+
+// Image of the black box test, stream of the export test
+static uint8_t ui8Image[2048];
+
+/************************************************************************************
+ * Private function definitions
+ ***********************************************************************************/
+/********************************************************************************//**
+ * \brief Services the datalogger until the capture is complete.
+ *
+ * The variable is incremented after every service call, so each sample holds the
+ * tick it was taken at.
+ ***********************************************************************************/
+static void _TestRun (tDATALOGGER *psDatalog, uint16_t *pui16Var)
+{
+    while (DataloggerGetCurrentState(psDatalog) == eDLOGSTATE_RUNNING)
+    {
+        DataloggerService(psDatalog);
+        (*pui16Var)++;
+    }
+
+    DataloggerStatemachine(psDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Gather hook of the tests, copies with memcpy and counts the batches.
+ ***********************************************************************************/
+static void _TestGather (const tDATALOG_GATHER_DESC *psDesc, uint8_t ui8Count, void *pvCtx)
+{
+    ui32GatherCalls++;
+
+    if (ui8Count > ui8GatherMaxCount)
+        ui8GatherMaxCount = ui8Count;
+
+    DataloggerGatherMemcpy(psDesc, ui8Count, pvCtx);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Storage with asynchronous reads, busy for two polls after a read.
+ ***********************************************************************************/
+static tDATALOG_ERROR _TestReadAsync (uint32_t ui32Addr, uint8_t *pui8Data, uint32_t ui32Len, void *pvCtx)
+{
+    (void)pvCtx;
+    memcpy(pui8Data, &ui8Storage[ui32Addr], ui32Len);
+    ui8ReadBusy = 2;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+static bool _TestReadBusy (void *pvCtx)
+{
+    (void)pvCtx;
+
+    if (ui8ReadBusy)
+        ui8ReadBusy--;
+
+    return ui8ReadBusy != 0;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Blocking upstream, appends to ui8Received.
+ ***********************************************************************************/
+static tDATALOG_ERROR _TestSend (const uint8_t *pui8Data, uint32_t ui32Len, void *pvCtx)
+{
+    (void)pvCtx;
+
+    if (ui32ReceivedLen + ui32Len > sizeof(ui8Received))
+        return eDATALOG_ERROR_IO;
+
+    memcpy(&ui8Received[ui32ReceivedLen], pui8Data, ui32Len);
+    ui32ReceivedLen += ui32Len;
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Blocking NOR flash backend.
+ ***********************************************************************************/
+static tDATALOG_ERROR _TestFlashWrite (uint32_t ui32Addr, const uint8_t *pui8Data, uint32_t ui32Len, void *pvCtx)
+{
+    (void)pvCtx;
+
+    for (uint32_t i = 0; i < ui32Len; i++)
+        ui8Flash[ui32Addr + i] &= pui8Data[i];
+
+    return eDATALOG_ERROR_NONE;
+}
+
+static tDATALOG_ERROR _TestFlashRead (uint32_t ui32Addr, uint8_t *pui8Data, uint32_t ui32Len, void *pvCtx)
+{
+    (void)pvCtx;
+    memcpy(pui8Data, &ui8Flash[ui32Addr], ui32Len);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+static tDATALOG_ERROR _TestFlashErase (uint32_t ui32Addr, uint32_t ui32Len, void *pvCtx)
+{
+    (void)pvCtx;
+    memset(&ui8Flash[ui32Addr], 0xFF, ui32Len);
+
+    return eDATALOG_ERROR_NONE;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Writes ui32Len bytes of the salted test pattern as a flash log capture.
+ *
+ * @param bEnd  false: The capture is left open (power loss while recording).
+ ***********************************************************************************/
+static void _TestFlashPut (tDATALOG_FLASHLOG *pLog, uint32_t ui32Len, uint8_t ui8Salt, bool bEnd)
+{
+    uint32_t ui32Done = 0, ui32Written;
+
+    for (uint32_t i = 0; i < ui32Len; i++)
+        ui8Payload[i] = (uint8_t)(i * 31 + ui8Salt);
+
+    CHECK(DataloggerFlashLogBegin(pLog) == eDATALOG_ERROR_NONE);
+
+    while (ui32Done < ui32Len)
+    {
+        CHECK(DataloggerFlashLogWrite(pLog, &ui8Payload[ui32Done], ui32Len - ui32Done, &ui32Written) == eDATALOG_ERROR_NONE);
+        ui32Done += ui32Written;
+        DataloggerFlashLogService(pLog);
+    }
+
+    if (bEnd)
+    {
+        while (DataloggerFlashLogEnd(pLog) == eDATALOG_ERROR_BUFFER_LOCKED)
+            DataloggerFlashLogService(pLog);
+    }
+
+    for (uint8_t i = 0; i < 20; i++)
+        DataloggerFlashLogService(pLog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Checks that the latest capture holds the salted test pattern.
+ ***********************************************************************************/
+static void _TestFlashCheckLatest (tDATALOG_FLASHLOG *pLog, uint32_t ui32Len, uint8_t ui8Salt)
+{
+    tDATALOG_FLASHLOG_CAPTURE sCapture;
+    static uint8_t ui8Read[sizeof(ui8Payload)];
+
+    CHECK(DataloggerFlashLogLatest(pLog, &sCapture) == eDATALOG_ERROR_NONE && sCapture.ui32Length == ui32Len);
+    CHECK(DataloggerFlashLogRead(pLog, &sCapture, 0, ui8Read, ui32Len) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerFlashLogCheck(pLog, &sCapture) == eDATALOG_ERROR_NONE);
+
+    for (uint32_t i = 0; i < ui32Len; i++)
+    {
+        if (ui8Read[i] != (uint8_t)(i * 31 + ui8Salt))
+        {
+            CHECK(ui8Read[i] == (uint8_t)(i * 31 + ui8Salt));
+            break;
+        }
+    }
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Reads a little endian u32 of the export stream.
+ ***********************************************************************************/
+static uint32_t _TestGet32 (const uint8_t *pui8Src)
+{
+    return (uint32_t)pui8Src[0] | ((uint32_t)pui8Src[1] << 8) | ((uint32_t)pui8Src[2] << 16) | ((uint32_t)pui8Src[3] << 24);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Decodes channel descriptor ui8Desc of an export stream into a view on 
+ * the stream data.
+ *
+ * @returns Descriptor, NULL if the stream has no such channel.
+ ***********************************************************************************/
+static const uint8_t* _TestStreamView (const uint8_t *pui8Stream, uint8_t ui8Desc, tDATALOG_CHANNEL_VIEW *pView, tDATALOG_SCALING *pScaling)
+{
+    const uint8_t *pui8Desc = &pui8Stream[DATALOGGER_EXPORT_FILE_HEADER_SIZE];
+    uint32_t ui32Offset = _TestGet32(&pui8Stream[12]);
+    uint32_t ui32Val;
+
+    if (memcmp(pui8Stream, "DLOG", 4) != 0 || ui8Desc >= pui8Stream[6])
+        return NULL;
+
+    for (uint8_t i = 0; i < ui8Desc; i++)
+        ui32Offset += _TestGet32(&pui8Desc[i * DATALOGGER_EXPORT_CHANNEL_HEADER_SIZE + 16]);
+
+    pui8Desc += ui8Desc * DATALOGGER_EXPORT_CHANNEL_HEADER_SIZE;
+
+    pView->pui8Base = &pui8Stream[ui32Offset];
+    pView->ui32Count = _TestGet32(&pui8Desc[12]);
+    pView->eEncoding = (tDATALOG_ENCODING)pui8Desc[5];
+    pView->ui8Width = pui8Desc[6];
+    pView->ui8BitWidth = pui8Desc[7];
+    pView->ui16Stride = pui8Desc[6];
+
+    pScaling->eType = (tDATALOG_DATATYPE)pui8Desc[10];
+    ui32Val = _TestGet32(&pui8Desc[20]);
+    memcpy(&pScaling->fGain, &ui32Val, 4);
+    ui32Val = _TestGet32(&pui8Desc[24]);
+    memcpy(&pScaling->fOffset, &ui32Val, 4);
+
+    return pui8Desc;
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief A/B buffers: The last capture stays readable during the next run, a 
+ * locked buffer is not recorded into.
+ ***********************************************************************************/
+static void TestCaptureBuffers (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    uint16_t ui16Var = 0;
+    uint8_t *pui8First, *pui8Data;
+    uint32_t ui32Len;
+    uint8_t ui8BufIdx;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 1, 4, (uint8_t*)&ui16Var, 2) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+    _TestRun(&sDatalog, &ui16Var);
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_DATA_READY);
+    CHECK(DataloggerGetDataPtr(&sDatalog, &pui8First, &ui32Len) == eDATALOG_ERROR_NONE);
+    CHECK(ui32Len == 8 && pui8First[1] == 0 && pui8First[7] == 3);
+
+    // Second run records into the other buffer, the first capture is unchanged
+    CHECK(DataloggerLockReadout(&sDatalog, &ui8BufIdx) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+    DataloggerService(&sDatalog);
+    ui16Var++;
+    CHECK(DataloggerGetDataPtr(&sDatalog, &pui8Data, &ui32Len) == eDATALOG_ERROR_NONE);
+    CHECK(pui8Data == pui8First && pui8Data[7] == 3);
+    _TestRun(&sDatalog, &ui16Var);
+    CHECK(DataloggerGetDataPtr(&sDatalog, &pui8Data, &ui32Len) == eDATALOG_ERROR_NONE);
+    CHECK(pui8Data != pui8First && pui8Data[1] == 4 && pui8Data[7] == 7);
+
+    // The third run would overwrite the locked first capture
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_BUFFER_LOCKED);
+    CHECK(DataloggerReset(&sDatalog) == eDATALOG_ERROR_BUFFER_LOCKED);
+    CHECK(pui8First[7] == 3);
+    DataloggerUnlockReadout(&sDatalog, ui8BufIdx);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+    _TestRun(&sDatalog, &ui16Var);
+    CHECK(DataloggerGetDataPtr(&sDatalog, &pui8Data, &ui32Len) == eDATALOG_ERROR_NONE);
+    CHECK(pui8Data == pui8First && pui8Data[1] == 8);
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Sequence mode: Triggered segments share the record length, their start
+ * ticks are kept in the segment table.
+ ***********************************************************************************/
+static void TestSegments (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    const uint32_t ui32Triggers[3] = {5, 20, 30};
+    tDATALOG_CHANNEL_VIEW sView;
+    tDATALOG_SEGMENT sSegment;
+    uint8_t ui8Var = 0;
+    uint16_t ui16Seg;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 1, 6, &ui8Var, 1) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetSequence(&sDatalog, 3, eSEQMODE_TRIGGERED) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    for (uint32_t t = 0; t < 40; t++)
+    {
+        if (t == ui32Triggers[0] || t == ui32Triggers[1] || t == ui32Triggers[2])
+            DataloggerTrigger(&sDatalog);
+
+        DataloggerService(&sDatalog);
+        ui8Var++;
+    }
+
+    DataloggerStatemachine(&sDatalog);
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_DATA_READY);
+
+    // Two samples per segment, starting at the trigger
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE);
+    CHECK(sView.ui32Count == 6);
+
+    for (ui16Seg = 0; DataloggerGetSegmentInfo(&sDatalog, &sSegment, ui16Seg) == eDATALOG_ERROR_NONE; ui16Seg++)
+    {
+        CHECK(sSegment.ui16SegmentIdx == ui16Seg && sSegment.ui32StartTick == ui32Triggers[ui16Seg]);
+        CHECK(DataloggerViewGetSample(&sView, 2 * ui16Seg) == ui32Triggers[ui16Seg]);
+        CHECK(DataloggerViewGetSample(&sView, 2 * ui16Seg + 1) == ui32Triggers[ui16Seg] + 1);
+    }
+
+    CHECK(ui16Seg == 3);
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Runtime divider changes: Markers record the change and the stop of a
+ * channel, sample ticks follow them and the next start restores the divider.
+ ***********************************************************************************/
+static void TestDividerMarkers (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_CHANNEL_VIEW sView;
+    tDATALOG_RATE_MARKER sMarker;
+    uint32_t ui32Var = 0;
+    uint32_t ui32Tick, k;
+    uint16_t ui16Divider;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 10, 20, (uint8_t*)&ui32Var, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterLog(&sDatalog, 2, 2, 1, 40, (uint8_t*)&ui32Var, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelDivider(&sDatalog, 1, 2) == eDATALOG_ERROR_WRONG_STATE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    // Channel 1 samples at 0, 10, 20, 30, then every 2nd tick from 36 on
+    for (; ui32Var < 35; ui32Var++)
+        DataloggerService(&sDatalog);
+
+    CHECK(DataloggerSetChannelDivider(&sDatalog, 1, 2) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelDivider(&sDatalog, 1, 0) == eDATALOG_ERROR_INVALID_PARAMETER);
+
+    for (; ui32Var < 39; ui32Var++)
+        DataloggerService(&sDatalog);
+
+    CHECK(DataloggerStopChannel(&sDatalog, 2) == eDATALOG_ERROR_NONE);
+
+    for (; ui32Var < 200 && DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_RUNNING; ui32Var++)
+        DataloggerService(&sDatalog);
+
+    DataloggerStatemachine(&sDatalog);
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_DATA_READY);
+
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE && sView.ui32Count == 20);
+
+    for (k = 0; k < sView.ui32Count; k++)
+        CHECK(DataloggerGetSampleTick(&sDatalog, 1, k, &ui32Tick) == eDATALOG_ERROR_NONE && ui32Tick == DataloggerViewGetSample(&sView, k));
+
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 2) == eDATALOG_ERROR_NONE && sView.ui32Count == 39);
+
+    CHECK(DataloggerGetRateMarker(&sDatalog, &sMarker, 0) == eDATALOG_ERROR_NONE);
+    CHECK(sMarker.ui8LogNum == 1 && sMarker.ui16OldDivider == 10 && sMarker.ui16Divider == 2);
+    CHECK(sMarker.ui32SampleIdx == 4 && sMarker.ui32Tick == 36);
+    CHECK(DataloggerGetRateMarker(&sDatalog, &sMarker, 1) == eDATALOG_ERROR_NONE);
+    CHECK(sMarker.ui8LogNum == 2 && sMarker.ui16Divider == 0 && sMarker.ui32SampleIdx == 39);
+    CHECK(DataloggerGetRateMarker(&sDatalog, &sMarker, 2) == eDATALOG_ERROR_NO_DATA);
+    CHECK(DataloggerGetCaptureDivider(&sDatalog, 1, &ui16Divider) == eDATALOG_ERROR_NONE && ui16Divider == 10);
+
+    // The next capture starts with the registered divider and without markers
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+    ui32Var = 0;
+
+    for (; ui32Var < 200 && DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_RUNNING; ui32Var++)
+        DataloggerService(&sDatalog);
+
+    DataloggerStatemachine(&sDatalog);
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerViewGetSample(&sView, 1) == 10 && DataloggerViewGetSample(&sView, 19) == 190);
+    CHECK(DataloggerGetRateMarker(&sDatalog, &sMarker, 0) == eDATALOG_ERROR_NO_DATA);
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Block CRCs: Every block of a RAM capture is covered, corrupted blocks 
+ * are reported per channel.
+ ***********************************************************************************/
+static void TestBlockCrc (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_CHANNEL_VIEW sView;
+    uint32_t ui32Var = 0;
+    uint16_t ui16Adc = 0;
+    uint8_t ui8BadChannels = 0xFF;
+    uint32_t ui32Crc, ui32Len, ui32Block;
+
+    CHECK(DataloggerCrc32Update(0, (const uint8_t*)"123456789", 9) == 0xCBF43926u);
+    CHECK(DataloggerCrc32Update(DataloggerCrc32Update(0, (const uint8_t*)"1234", 4), (const uint8_t*)"56789", 5) == 0xCBF43926u);
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 0x100, 1, 1, 150, (uint8_t*)&ui32Var, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterPackedLog(&sDatalog, 0x200, 3, 1, 300, (uint8_t*)&ui16Adc, 2, 11) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerCheckCapture(&sDatalog, &ui8BadChannels) == eDATALOG_ERROR_WRONG_STATE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    for (uint32_t t = 0; t < 400; t++)
+    {
+        ui32Var = 0x12345678u * t;
+        ui16Adc = (uint16_t)(t * 13);
+        DataloggerService(&sDatalog);
+    }
+
+    DataloggerStatemachine(&sDatalog);
+
+    // Block CRCs of the packed channel match the data of its view
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 3) == eDATALOG_ERROR_NONE);
+    ui32Len = DataloggerViewGetLength(&sView);
+
+    for (ui32Block = 0; ui32Block * DATALOGGER_CRC_BLOCK_SIZE < ui32Len; ui32Block++)
+    {
+        uint32_t ui32BlockLen = ui32Len - ui32Block * DATALOGGER_CRC_BLOCK_SIZE;
+
+        if (ui32BlockLen > DATALOGGER_CRC_BLOCK_SIZE)
+            ui32BlockLen = DATALOGGER_CRC_BLOCK_SIZE;
+
+        CHECK(DataloggerGetBlockCrc(&sDatalog, 3, (uint16_t)ui32Block, &ui32Crc) == eDATALOG_ERROR_NONE);
+        CHECK(ui32Crc == DataloggerCrc32Update(0, sView.pui8Base + ui32Block * DATALOGGER_CRC_BLOCK_SIZE, ui32BlockLen));
+    }
+
+    CHECK(ui32Block == 2);
+    CHECK(DataloggerGetBlockCrc(&sDatalog, 3, (uint16_t)ui32Block, &ui32Crc) == eDATALOG_ERROR_NO_DATA);
+    CHECK(DataloggerCheckCapture(&sDatalog, &ui8BadChannels) == eDATALOG_ERROR_NONE && ui8BadChannels == 0);
+
+    // A flipped bit in the last (short) block
+    ((uint8_t*)sView.pui8Base)[300] ^= 0x55;
+    CHECK(DataloggerCheckCapture(&sDatalog, &ui8BadChannels) == eDATALOG_ERROR_CRC && ui8BadChannels == 0x04);
+    ((uint8_t*)sView.pui8Base)[300] ^= 0x55;
+    CHECK(DataloggerCheckCapture(&sDatalog, &ui8BadChannels) == eDATALOG_ERROR_NONE && ui8BadChannels == 0);
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Committed view: Samples of a running capture become visible once they
+ * are complete, bit streams in whole words.
+ ***********************************************************************************/
+static void TestCommittedView (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_CHANNEL_VIEW sView;
+    uint32_t ui32Var = 0;
+    uint8_t ui8Flags = 0;
+    uint32_t t, k;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 1, 200, (uint8_t*)&ui32Var, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterPackedLog(&sDatalog, 2, 2, 1, 200, &ui8Flags, 1, 3) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerGetCommittedView(&sDatalog, &sView, 1) == eDATALOG_ERROR_WRONG_STATE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerGetCommittedView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE && sView.ui32Count == 0);
+
+    for (t = 0; t < 5; t++)
+    {
+        ui32Var = t * 7 + 1;
+        ui8Flags = (uint8_t)(ui32Var & 7);
+        DataloggerService(&sDatalog);
+    }
+
+    CHECK(DataloggerGetCommittedView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE && sView.ui32Count == 5);
+
+    for (k = 0; k < sView.ui32Count; k++)
+        CHECK(DataloggerViewGetSample(&sView, k) == k * 7 + 1);
+
+    // 15 bits, no complete word yet
+    CHECK(DataloggerGetCommittedView(&sDatalog, &sView, 2) == eDATALOG_ERROR_NONE && sView.ui32Count == 0);
+
+    for (; t < 11; t++)
+    {
+        ui32Var = t * 7 + 1;
+        ui8Flags = (uint8_t)(ui32Var & 7);
+        DataloggerService(&sDatalog);
+    }
+
+    // 33 bits, the first word holds 10 samples
+    CHECK(DataloggerGetCommittedView(&sDatalog, &sView, 2) == eDATALOG_ERROR_NONE && sView.ui32Count == 10);
+
+    for (k = 0; k < sView.ui32Count; k++)
+        CHECK(DataloggerViewGetSample(&sView, k) == ((k * 7 + 1) & 7));
+
+    DataloggerStop(&sDatalog);
+    DataloggerStatemachine(&sDatalog);
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Gather mode: Byte aligned channels are copied by the hook in one batch
+ * per tick, a re-registered variable is copied from its new address.
+ ***********************************************************************************/
+static void TestGather (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_CHANNEL_VIEW sView;
+    uint32_t ui32Var = 0, ui32Other = 0;
+    int16_t i16Var = 0;
+    uint16_t ui16Adc = 0;
+    uint32_t t;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 1, 10, (uint8_t*)&ui32Var, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterLog(&sDatalog, 2, 2, 2, 5, (uint8_t*)&i16Var, 2) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterPackedLog(&sDatalog, 3, 3, 1, 10, (uint8_t*)&ui16Adc, 2, 12) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetGather(&sDatalog, _TestGather, NULL) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    for (t = 0; t < 10; t++)
+    {
+        ui32Var = 0x11223344u + t;
+        i16Var = (int16_t)(-(int32_t)t);
+        ui16Adc = (uint16_t)(t * 100);
+        DataloggerService(&sDatalog);
+    }
+
+    DataloggerStatemachine(&sDatalog);
+
+    // The packed channel is sampled directly, the others by the hook
+    CHECK(ui32GatherCalls == 10 && ui8GatherMaxCount == 2);
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE);
+    CHECK(sView.eEncoding == eDATALOG_ENCODING_NATIVE && DataloggerViewGetSample(&sView, 3) == 0x11223347u);
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 2) == eDATALOG_ERROR_NONE);
+    CHECK(sView.ui32Count == 5 && (int16_t)DataloggerViewGetSample(&sView, 2) == -4);
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 3) == eDATALOG_ERROR_NONE);
+    CHECK(sView.eEncoding == eDATALOG_ENCODING_BITPACKED && DataloggerViewGetSample(&sView, 9) == 900);
+
+    // The published capture was recorded from the old variable, it is dropped
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 1, 10, (uint8_t*)&ui32Var, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_UNINITIALIZED);
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) != eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+
+    // Same footprint, new variable: The layout is kept
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 1, 10, (uint8_t*)&ui32Other, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_INITIALIZED);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    for (t = 0; t < 10; t++)
+    {
+        ui32Other = 500 + t;
+        DataloggerService(&sDatalog);
+    }
+
+    DataloggerStatemachine(&sDatalog);
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE && DataloggerViewGetSample(&sView, 3) == 503);
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Re-registering a channel with the same footprint resets its timebase and
+ * scaling, the logger has to be initialized again.
+ ***********************************************************************************/
+static void TestReregister (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_SCALING sScaling = {eDATALOG_TYPE_UINT, 0.5f, 0.0f};
+    uint32_t ui32Var = 0;
+    uint32_t ui32Tick = 0;
+    uint32_t t;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 1, 10, (uint8_t*)&ui32Var, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetTimebase(&sDatalog, 1, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelTimebase(&sDatalog, 1, 1) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelScaling(&sDatalog, 1, sScaling) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+
+    // Same footprint, but back on timebase 0 with the default scaling
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 1, 10, (uint8_t*)&ui32Var, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_UNINITIALIZED);
+    CHECK(DataloggerStart(&sDatalog) != eDATALOG_ERROR_NONE);
+
+    CHECK(DataloggerSetChannelTimebase(&sDatalog, 1, 1) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelScaling(&sDatalog, 1, sScaling) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    for (t = 0; t < 40; t++)
+    {
+        ui32Var = t;
+        if (!(t % 4))
+            DataloggerServiceTimebase(&sDatalog, 1);
+        DataloggerService(&sDatalog);
+    }
+
+    DataloggerStatemachine(&sDatalog);
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_DATA_READY);
+    CHECK(DataloggerGetSampleTick(&sDatalog, 1, 3, &ui32Tick) == eDATALOG_ERROR_NONE && ui32Tick == 12);
+
+    // A capture with a changed setup must not be decoded with the old one
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 1, 10, (uint8_t*)&ui32Var, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_UNINITIALIZED);
+    CHECK(DataloggerGetSampleTick(&sDatalog, 1, 3, &ui32Tick) != eDATALOG_ERROR_NONE);
+    CHECK(DataloggerGetChannelScaling(&sDatalog, &sScaling, 1) == eDATALOG_ERROR_NONE && sScaling.fGain == 1.0f);
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Ring mode: A wrapped capture is unrolled to the last samples before the
+ * stop, oldest first, with their ticks.
+ ***********************************************************************************/
+static void TestRingUnroll (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_CHANNEL_VIEW sView;
+    uint32_t ui32Var = 0;
+    uint16_t ui16Var = 0;
+    uint32_t ui32Tick, k;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 3, 10, (uint8_t*)&ui32Var, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterLog(&sDatalog, 2, 2, 1, 7, (uint8_t*)&ui16Var, 2) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetSequence(&sDatalog, 2, eSEQMODE_RING) == eDATALOG_ERROR_INVALID_PARAMETER);
+    CHECK(DataloggerSetSequence(&sDatalog, 1, eSEQMODE_RING) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    // Records until stopped
+    for (ui32Var = 0; ui32Var < 100; ui32Var++)
+    {
+        ui16Var = (uint16_t)ui32Var;
+        DataloggerService(&sDatalog);
+    }
+
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_RUNNING);
+    DataloggerStop(&sDatalog);
+    DataloggerStatemachine(&sDatalog);
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_DATA_READY);
+
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE && sView.ui32Count == 10);
+
+    for (k = 0; k < sView.ui32Count; k++)
+    {
+        CHECK(DataloggerGetSampleTick(&sDatalog, 1, k, &ui32Tick) == eDATALOG_ERROR_NONE);
+        CHECK(ui32Tick == 99 - 3 * (9 - k) && DataloggerViewGetSample(&sView, k) == ui32Tick);
+    }
+
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 2) == eDATALOG_ERROR_NONE && sView.ui32Count == 7);
+
+    for (k = 0; k < sView.ui32Count; k++)
+    {
+        CHECK(DataloggerGetSampleTick(&sDatalog, 2, k, &ui32Tick) == eDATALOG_ERROR_NONE);
+        CHECK(ui32Tick == 93 + k && DataloggerViewGetSample(&sView, k) == ui32Tick);
+    }
+
+    // Stopped before the wrap, the capture is kept as recorded
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    for (ui32Var = 0; ui32Var < 5; ui32Var++)
+    {
+        ui16Var = (uint16_t)ui32Var;
+        DataloggerService(&sDatalog);
+    }
+
+    DataloggerStop(&sDatalog);
+    DataloggerStatemachine(&sDatalog);
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 2) == eDATALOG_ERROR_NONE);
+    CHECK(sView.ui32Count == 5 && DataloggerViewGetSample(&sView, 0) == 0);
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Histogram channels: Values are counted into bins, out of range values 
+ * into the outer bins. Every start clears the bins.
+ ***********************************************************************************/
+static void TestHistogram (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    // Values -128 - 127 in bins of 16 from -64 to 64
+    const uint32_t ui32Expected[8] = {80, 16, 16, 16, 16, 16, 16, 80};
+    tDATALOG_CHANNEL_VIEW sView;
+    tDATALOG_CHANNEL sChannel;
+    int16_t i16Var = 0;
+    uint8_t ui8Var = 0;
+    uint32_t k;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterHistogramLog(&sDatalog, 1, 1, 1, 8, (uint8_t*)&i16Var, 2, true, -64, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterHistogramLog(&sDatalog, 2, 2, 2, 4, &ui8Var, 1, false, 0, 6) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterHistogramLog(&sDatalog, 3, 3, 1, 4, &ui8Var, 5, false, 0, 6) == eDATALOG_ERROR_INVALID_PARAMETER);
+    CHECK(DataloggerGetChannelInfo(&sDatalog, &sChannel, 1) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerGetChannelKind(&sChannel) == eDATALOG_CHKIND_HISTOGRAM);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+
+    for (uint8_t ui8Run = 0; ui8Run < 2; ui8Run++)
+    {
+        CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+        for (uint32_t t = 0; t < 256; t++)
+        {
+            i16Var = (int16_t)(t - 128);
+            ui8Var = (uint8_t)t;
+            DataloggerService(&sDatalog);
+        }
+
+        DataloggerStop(&sDatalog);
+        DataloggerStatemachine(&sDatalog);
+
+        CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE);
+        CHECK(sView.ui32Count == 8 && sView.ui8Width == 4);
+
+        for (k = 0; k < 8; k++)
+            CHECK(DataloggerViewGetSample(&sView, k) == ui32Expected[k]);
+
+        // Every 2nd value of 0 - 255 in 4 bins
+        CHECK(DataloggerGetChannelView(&sDatalog, &sView, 2) == eDATALOG_ERROR_NONE && sView.ui32Count == 4);
+
+        for (k = 0; k < 4; k++)
+            CHECK(DataloggerViewGetSample(&sView, k) == 32);
+    }
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief CIC decimation: A tone at the divider frequency is filtered instead of 
+ * aliased, a ramp passes with the group delay of the filter.
+ ***********************************************************************************/
+static void TestDecimation (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_SCALING sScaling = tDATALOG_SCALING_DEFAULTS;
+    // Period of 4 ticks around -300
+    const int16_t i16Tone[4] = {700, -300, -1300, -300};
+    tDATALOG_CHANNEL_VIEW sView;
+    int16_t i16Var = 0;
+    uint16_t ui16Ramp = 0;
+    int32_t i32Var = 0;
+    uint32_t k;
+
+    sScaling.eType = eDATALOG_TYPE_INT;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 4, 20, (uint8_t*)&i16Var, 2) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterLog(&sDatalog, 2, 2, 8, 10, (uint8_t*)&ui16Ramp, 2) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterLog(&sDatalog, 3, 3, 4, 20, (uint8_t*)&i16Var, 2) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterLog(&sDatalog, 4, 4, 2000, 2, (uint8_t*)&i32Var, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelScaling(&sDatalog, 1, sScaling) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelScaling(&sDatalog, 3, sScaling) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelDecimation(&sDatalog, 1, 1) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelDecimation(&sDatalog, 2, 3) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelDecimation(&sDatalog, 1, DATALOGGER_CIC_MAX_ORDER + 1) == eDATALOG_ERROR_INVALID_PARAMETER);
+    // The gain of 2000^3 exceeds the 64 bit accumulator of a 32 bit variable
+    CHECK(DataloggerSetChannelDecimation(&sDatalog, 4, 3) == eDATALOG_ERROR_INVALID_PARAMETER);
+    CHECK(DataloggerRemoveLog(&sDatalog, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    for (uint32_t t = 0; t < 80; t++)
+    {
+        i16Var = i16Tone[t & 3];
+        ui16Ramp = (uint16_t)(100 + t * 8);
+        DataloggerService(&sDatalog);
+    }
+
+    DataloggerStatemachine(&sDatalog);
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_DATA_READY);
+
+    // First sample raw (filter warming up), then the mean of the tone
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE);
+    CHECK((int16_t)DataloggerViewGetSample(&sView, 0) == 700);
+
+    for (k = 1; k < 20; k++)
+        CHECK((int16_t)DataloggerViewGetSample(&sView, k) == -300);
+
+    // The plain divider aliases the tone
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 3) == eDATALOG_ERROR_NONE);
+
+    for (k = 0; k < 20; k++)
+        CHECK((int16_t)DataloggerViewGetSample(&sView, k) == 700);
+
+    // Order 3, R = 8: Group delay of 3 * (8 - 1) / 2 = 10.5 ticks
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 2) == eDATALOG_ERROR_NONE);
+
+    for (k = 3; k < 10; k++)
+    {
+        int32_t i32Expected = 100 + 8 * (8 * (int32_t)k) - 84;
+        int32_t i32Sample = (int32_t)DataloggerViewGetSample(&sView, k);
+
+        CHECK(i32Sample >= i32Expected - 1 && i32Sample <= i32Expected + 1);
+    }
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief CIC decimation across a runtime divider change: The filter restarts 
+ * with the new divider, a constant input stays constant.
+ ***********************************************************************************/
+static void TestDecimationRateChange (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_SCALING sScaling = tDATALOG_SCALING_DEFAULTS;
+    tDATALOG_CHANNEL_VIEW sView;
+    int16_t i16Var = 100;
+    uint32_t t, k;
+
+    sScaling.eType = eDATALOG_TYPE_INT;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 10, 20, (uint8_t*)&i16Var, 2) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterLog(&sDatalog, 2, 2, 10, 20, (uint8_t*)&i16Var, 2) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelScaling(&sDatalog, 1, sScaling) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelScaling(&sDatalog, 2, sScaling) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelDecimation(&sDatalog, 1, 1) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelDecimation(&sDatalog, 2, 3) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    for (t = 0; t < 200 && DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_RUNNING; t++)
+    {
+        // Within the windows of both the old and the new divider
+        if (t == 35)
+        {
+            CHECK(DataloggerSetChannelDivider(&sDatalog, 1, 2) == eDATALOG_ERROR_NONE);
+            CHECK(DataloggerSetChannelDivider(&sDatalog, 2, 3) == eDATALOG_ERROR_NONE);
+        }
+
+        DataloggerService(&sDatalog);
+    }
+
+    DataloggerStatemachine(&sDatalog);
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_DATA_READY);
+
+    for (uint8_t ui8Ch = 1; ui8Ch <= 2; ui8Ch++)
+    {
+        CHECK(DataloggerGetChannelView(&sDatalog, &sView, ui8Ch) == eDATALOG_ERROR_NONE && sView.ui32Count == 20);
+
+        for (k = 0; k < sView.ui32Count; k++)
+            CHECK((int16_t)DataloggerViewGetSample(&sView, k) == 100);
+    }
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Streaming readout: A storage region arrives unchanged at the upstream, 
+ * regions beyond the storage are refused.
+ ***********************************************************************************/
+static void TestReadout (void)
+{
+    tDATALOG_STORAGE sStorage = tDATALOG_STORAGE_DEFAULTS;
+    tDATALOG_UPSTREAM sUpstream = tDATALOG_UPSTREAM_DEFAULTS;
+    tDATALOG_READOUT sReadout;
+    uint32_t ui32Calls = 0;
+
+    for (uint32_t i = 0; i < sizeof(ui8Storage); i++)
+        ui8Storage[i] = (uint8_t)(i * 7 + i / 256);
+
+    sStorage.ReadAsync = _TestReadAsync;
+    sUpstream.Send = _TestSend;
+
+    // Completion of asynchronous reads requires IsBusy
+    CHECK(DataloggerReadoutInit(&sReadout, &sStorage, &sUpstream, sizeof(ui8Storage)) == eDATALOG_ERROR_INVALID_PARAMETER);
+    sStorage.IsBusy = _TestReadBusy;
+    CHECK(DataloggerReadoutInit(&sReadout, &sStorage, &sUpstream, 0) == eDATALOG_ERROR_INVALID_PARAMETER);
+    CHECK(DataloggerReadoutInit(&sReadout, &sStorage, &sUpstream, sizeof(ui8Storage)) == eDATALOG_ERROR_NONE);
+
+    CHECK(DataloggerReadoutStart(&sReadout, 100, 0) == eDATALOG_ERROR_NO_DATA);
+    CHECK(DataloggerReadoutStart(&sReadout, 100, 901) == eDATALOG_ERROR_INVALID_PARAMETER);
+    CHECK(DataloggerReadoutStart(&sReadout, 0xFFFFFF00u, 0x200) == eDATALOG_ERROR_INVALID_PARAMETER);
+
+    // Several blocks, the last one shorter
+    CHECK(DataloggerReadoutStart(&sReadout, 100, 900) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerReadoutStart(&sReadout, 100, 900) == eDATALOG_ERROR_WRONG_STATE);
+
+    while (sReadout.eState == eREADOUT_RUNNING && ui32Calls < 1000)
+    {
+        CHECK(DataloggerReadoutService(&sReadout) == eDATALOG_ERROR_NONE);
+        ui32Calls++;
+    }
+
+    CHECK(sReadout.eState == eREADOUT_DONE && sReadout.ui32Sent == 900);
+    CHECK(ui32ReceivedLen == 900 && memcmp(ui8Received, &ui8Storage[100], 900) == 0);
+
+    // Aborted readouts complete the pending read first
+    ui32ReceivedLen = 0;
+    CHECK(DataloggerReadoutStart(&sReadout, 0, 1000) == eDATALOG_ERROR_NONE);
+    DataloggerReadoutService(&sReadout);
+    DataloggerReadoutAbort(&sReadout);
+
+    for (ui32Calls = 0; sReadout.eState == eREADOUT_RUNNING && ui32Calls < 1000; ui32Calls++)
+        DataloggerReadoutService(&sReadout);
+
+    CHECK(sReadout.eState == eREADOUT_IDLE && ui8ReadBusy == 0);
+    CHECK(ui32ReceivedLen < 1000 && memcmp(ui8Received, ui8Storage, ui32ReceivedLen) == 0);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Flash log: After a power loss the last completed capture is recovered,
+ * corrupted pages are detected.
+ ***********************************************************************************/
+static void TestFlashLogRecovery (void)
+{
+    tDATALOG_STORAGE sStorage = tDATALOG_STORAGE_DEFAULTS;
+    tDATALOG_FLASHLOG sLog, sRebooted;
+    tDATALOG_FLASHLOG_CAPTURE sCapture;
+    const uint32_t ui32Size = sizeof(ui8Flash);
+    uint32_t ui32Addr;
+
+    memset(ui8Flash, 0xFF, sizeof(ui8Flash));
+    sStorage.Write = _TestFlashWrite;
+    sStorage.Read = _TestFlashRead;
+    sStorage.Erase = _TestFlashErase;
+
+    // Unaligned base, size without a spare block
+    CHECK(DataloggerFlashLogInit(&sLog, &sStorage, 512, ui32Size - TEST_FLASH_BLOCK_SIZE, TEST_FLASH_BLOCK_SIZE) == eDATALOG_ERROR_INVALID_PARAMETER);
+    CHECK(DataloggerFlashLogInit(&sLog, &sStorage, 0, TEST_FLASH_BLOCK_SIZE, TEST_FLASH_BLOCK_SIZE) == eDATALOG_ERROR_INVALID_PARAMETER);
+    CHECK(DataloggerFlashLogInit(&sLog, &sStorage, 0, ui32Size, TEST_FLASH_BLOCK_SIZE) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerFlashLogBegin(&sLog) == eDATALOG_ERROR_WRONG_STATE);
+    CHECK(DataloggerFlashLogMount(&sLog) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerFlashLogLatest(&sLog, &sCapture) == eDATALOG_ERROR_NO_DATA);
+
+    _TestFlashPut(&sLog, 500, 1, true);
+    _TestFlashCheckLatest(&sLog, 500, 1);
+
+    // Power loss while recording the next capture
+    _TestFlashPut(&sLog, 700, 2, false);
+    CHECK(DataloggerFlashLogInit(&sRebooted, &sStorage, 0, ui32Size, TEST_FLASH_BLOCK_SIZE) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerFlashLogMount(&sRebooted) == eDATALOG_ERROR_NONE);
+    _TestFlashCheckLatest(&sRebooted, 500, 1);
+
+    // Recording continues behind the interrupted capture, also across the wrap
+    for (uint8_t k = 0; k < 10; k++)
+    {
+        _TestFlashPut(&sRebooted, 300 + k * 97, k, true);
+        _TestFlashCheckLatest(&sRebooted, 300 + k * 97, k);
+    }
+
+    CHECK(DataloggerFlashLogInit(&sLog, &sStorage, 0, ui32Size, TEST_FLASH_BLOCK_SIZE) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerFlashLogMount(&sLog) == eDATALOG_ERROR_NONE);
+    _TestFlashCheckLatest(&sLog, 300 + 9 * 97, 9);
+
+    // A flipped bit in the payload of the first page fails its CRC. Pages are 
+    // written in sequence order around the whole log.
+    CHECK(DataloggerFlashLogLatest(&sLog, &sCapture) == eDATALOG_ERROR_NONE);
+    ui32Addr = (sCapture.ui32FirstSeq % (ui32Size / DATALOGGER_FLASHLOG_PAGE_SIZE)) * DATALOGGER_FLASHLOG_PAGE_SIZE + 30;
+    ui8Flash[ui32Addr] ^= 0x01;
+    CHECK(DataloggerFlashLogCheck(&sLog, &sCapture) == eDATALOG_ERROR_CRC);
+    ui8Flash[ui32Addr] ^= 0x01;
+    CHECK(DataloggerFlashLogCheck(&sLog, &sCapture) == eDATALOG_ERROR_NONE);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Bit channels: A single flag and a scattered group of status bits are 
+ * packed into words, every sample is decoded with its tick.
+ ***********************************************************************************/
+static void TestBitChannels (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_CHANNEL_VIEW sView;
+    uint32_t ui32Fault = 0;
+    uint16_t ui16Status = 0;
+    uint32_t ui32Tick, ui32Expected;
+    uint32_t t, k;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterBitLog(&sDatalog, 1, 1, 1, 40, (uint8_t*)&ui32Fault, 4, 0x00010000) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterBitLog(&sDatalog, 2, 2, 2, 40, (uint8_t*)&ui16Status, 2, 0x8421) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterBitLog(&sDatalog, 3, 3, 1, 40, (uint8_t*)&ui16Status, 1, 0x100) == eDATALOG_ERROR_INVALID_PARAMETER);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    for (t = 0; t < 70; t++)
+    {
+        ui32Fault = (t % 3 == 0) ? 0xFFFFFFFFu : 0xFFFEFFFFu;
+        ui16Status = (uint16_t)(t * 0x1111);
+        DataloggerService(&sDatalog);
+    }
+
+    DataloggerStop(&sDatalog);
+    DataloggerStatemachine(&sDatalog);
+
+    // 40 single bit samples span two words
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE);
+    CHECK(sView.eEncoding == eDATALOG_ENCODING_BITPACKED && sView.ui8BitWidth == 1 && sView.ui32Count == 40);
+
+    for (k = 0; k < sView.ui32Count; k++)
+        CHECK(DataloggerViewGetSample(&sView, k) == (k % 3 == 0));
+
+    // Bits 0, 5, 10 and 15 are gathered into the low 4 bits, divider 2
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 2) == eDATALOG_ERROR_NONE);
+    CHECK(sView.ui8BitWidth == 4 && sView.ui32Count == 35);
+
+    for (k = 0; k < sView.ui32Count; k++)
+    {
+        ui16Status = (uint16_t)(2 * k * 0x1111);
+        ui32Expected = (ui16Status & 1) | ((ui16Status >> 4) & 2) | ((ui16Status >> 8) & 4) | ((ui16Status >> 12) & 8);
+        CHECK(DataloggerViewGetSample(&sView, k) == ui32Expected);
+        CHECK(DataloggerGetSampleTick(&sDatalog, 2, k, &ui32Tick) == eDATALOG_ERROR_NONE && ui32Tick == 2 * k);
+    }
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Packed channels: Signed 12 bit samples are sign extended on readout,
+ * also when they straddle two words.
+ ***********************************************************************************/
+static void TestPackedSignExtension (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_SCALING sScaling = {eDATALOG_TYPE_INT, 0.25f, 0.0f};
+    tDATALOG_CHANNEL_VIEW sView;
+    int16_t i16Adc = 0;
+    uint32_t ui32Raw[50];
+    float fValues[50];
+    uint32_t ui32Tick;
+    uint32_t t, k;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterPackedLog(&sDatalog, 1, 1, 3, 50, (uint8_t*)&i16Adc, 2, 12) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterPackedLog(&sDatalog, 2, 2, 1, 50, (uint8_t*)&i16Adc, 2, 17) == eDATALOG_ERROR_INVALID_PARAMETER);
+    CHECK(DataloggerSetChannelScaling(&sDatalog, 1, sScaling) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    // Sweeps -2048 ... 2047, the upper bits of the variable are set for negative values
+    for (t = 0; t < 150; t++)
+    {
+        i16Adc = (int16_t)(((int32_t)t * 83) % 4096 - 2048);
+        DataloggerService(&sDatalog);
+    }
+
+    DataloggerStatemachine(&sDatalog);
+
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE);
+    CHECK(sView.eEncoding == eDATALOG_ENCODING_BITPACKED && sView.ui8BitWidth == 12 && sView.ui32Count == 50);
+
+    // The raw samples hold the 12 bits, the conversion sign extends them
+    CHECK(DataloggerViewUnpack(&sView, ui32Raw, 0, 50) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerConvertToFloat(&sView, &sScaling, fValues, 0, 50) == eDATALOG_ERROR_NONE);
+
+    for (k = 0; k < 50; k++)
+    {
+        int32_t i32Expected = (int32_t)(3 * k * 83) % 4096 - 2048;
+
+        CHECK(ui32Raw[k] == ((uint32_t)i32Expected & 0xFFF));
+        CHECK(fValues[k] == 0.25f * (float)i32Expected);
+        CHECK(DataloggerGetSampleTick(&sDatalog, 1, k, &ui32Tick) == eDATALOG_ERROR_NONE && ui32Tick == 3 * k);
+    }
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Shards: Two shards serviced alternately (one per core) are merged into
+ * one capture ordered by tick, the gather hook of the configuration is used by 
+ * the shards.
+ ***********************************************************************************/
+static void TestShardMerge (void)
+{
+    tDATALOGGER sConfig = tDATALOGGER_DEFAULTS;
+    tDATALOGGER sShards[2] = {tDATALOGGER_DEFAULTS, tDATALOGGER_DEFAULTS};
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_SHARD_SET sSet = tDATALOG_SHARD_SET_DEFAULTS;
+    tDATALOG_SHARD_SAMPLE sSamples[7];
+    const uint8_t ui8Owner[MAX_NUM_LOGS] = {0, 1, 0};
+    uint32_t ui32Fast = 0, ui32Other = 0;
+    uint16_t ui16Slow = 0;
+    uint32_t ui32Count, ui32Total = 0, ui32LastTick = 0;
+    uint32_t t, k;
+
+    DataloggerInit(&sConfig, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sConfig, 10, 1, 2, 10, (uint8_t*)&ui32Fast, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterLog(&sConfig, 20, 2, 1, 20, (uint8_t*)&ui32Other, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterLog(&sConfig, 30, 3, 5, 4, (uint8_t*)&ui16Slow, 2) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetGather(&sConfig, _TestGather, NULL) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerShardInit(&sSet, sShards, 2, &sConfig, ui8Owner) == eDATALOG_ERROR_NONE);
+    CHECK(sShards[0].sGather.pfnGather == _TestGather && sShards[1].sGather.pfnGather == _TestGather);
+    CHECK(DataloggerShardStart(&sSet) == eDATALOG_ERROR_NONE);
+
+    ui32GatherCalls = 0;
+
+    for (t = 0; t < 20; t++)
+    {
+        ui32Other = 1000 + t;
+        DataloggerService(&sShards[1]);
+        ui32Fast = t;
+        ui16Slow = (uint16_t)(2000 + t);
+        DataloggerService(&sShards[0]);
+    }
+
+    DataloggerStatemachine(&sShards[0]);
+    DataloggerStatemachine(&sShards[1]);
+    CHECK(ui32GatherCalls > 0);
+
+    CHECK(DataloggerShardMergeBegin(&sSet) == eDATALOG_ERROR_NONE);
+
+    do
+    {
+        CHECK(DataloggerShardMerge(&sSet, sSamples, 7, &ui32Count) == eDATALOG_ERROR_NONE);
+
+        for (k = 0; k < ui32Count; k++)
+        {
+            CHECK(sSamples[k].ui32Tick >= ui32LastTick);
+            ui32LastTick = sSamples[k].ui32Tick;
+
+            switch (sSamples[k].ui8LogNum)
+            {
+                case 1:
+                    CHECK(sSamples[k].ui8Shard == 0 && sSamples[k].ui32Tick % 2 == 0 && sSamples[k].ui64Value == sSamples[k].ui32Tick);
+                    break;
+
+                case 2:
+                    CHECK(sSamples[k].ui8Shard == 1 && sSamples[k].ui64Value == 1000 + sSamples[k].ui32Tick);
+                    break;
+
+                default:
+                    CHECK(sSamples[k].ui8LogNum == 3 && sSamples[k].ui32Tick % 5 == 0 && sSamples[k].ui64Value == 2000 + sSamples[k].ui32Tick);
+                    break;
+            }
+        }
+
+        ui32Total += ui32Count;
+    } while (ui32Count);
+
+    CHECK(ui32Total == 10 + 20 + 4);
+
+    // The captures stay locked until the merge is ended
+    CHECK(DataloggerShardStart(&sSet) == eDATALOG_ERROR_BUFFER_LOCKED);
+    DataloggerShardMergeEnd(&sSet);
+
+    DataloggerReset(&sShards[0]);
+    DataloggerReset(&sShards[1]);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Replay: Recorded samples are written back at their ticks. A restarted 
+ * replay begins again with the first sample, also when advanced in batches.
+ ***********************************************************************************/
+static void TestReplay (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_CHANNEL_VIEW sView;
+    uint32_t ui32Var = 0;
+    uint8_t ui8Record[40];
+    uint32_t ui32Len, ui32Done;
+    uint32_t t, r;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 4, 10, (uint8_t*)&ui32Var, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    for (t = 0; t < 40; t++)
+    {
+        ui32Var = 0x10000u + t;
+        DataloggerService(&sDatalog);
+    }
+
+    DataloggerStatemachine(&sDatalog);
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE && sView.ui32Count == 10);
+    ui32Len = DataloggerViewGetLength(&sView);
+    CHECK(ui32Len == sizeof(ui8Record));
+    memcpy(ui8Record, sView.pui8Base, sizeof(ui8Record));
+
+    CHECK(DataloggerSetOpMode(&sDatalog, eOPMODE_REPLAY) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerReplayLoad(&sDatalog, 1, ui8Record, sizeof(ui8Record)) == eDATALOG_ERROR_NONE);
+
+    // Tick by tick, the variable holds the last replayed sample between the due ticks
+    for (r = 0; r < 2; r++)
+    {
+        CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+        ui32Var = 0;
+
+        for (t = 0; t < 40; t++)
+        {
+            DataloggerService(&sDatalog);
+            CHECK(ui32Var == 0x10000u + (t & ~3u));
+        }
+
+        DataloggerStatemachine(&sDatalog);
+        CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_DATA_READY);
+    }
+
+    // Batches across the end of the replay
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerReplayAdvance(&sDatalog, 6, &ui32Done) == eDATALOG_ERROR_NONE && ui32Done == 6 && ui32Var == 0x10004u);
+    CHECK(DataloggerReplayAdvance(&sDatalog, 1000, &ui32Done) == eDATALOG_ERROR_NONE && ui32Done == 31 && ui32Var == 0x10024u);
+    DataloggerStatemachine(&sDatalog);
+
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerReplayAdvance(&sDatalog, 1, &ui32Done) == eDATALOG_ERROR_NONE && ui32Done == 1 && ui32Var == 0x10000u);
+    DataloggerStop(&sDatalog);
+    DataloggerStatemachine(&sDatalog);
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Timebases: The ticks of slow channels are counted in base ticks, their
+ * dividers multiply with the ratio of the timebase.
+ ***********************************************************************************/
+static void TestTimebaseTicks (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_CHANNEL_VIEW sView;
+    uint16_t ui16Fast = 0;
+    uint32_t ui32Slow = 0;
+    uint32_t ui32Tick;
+    uint32_t t, k;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 1, 1, 3, 40, (uint8_t*)&ui16Fast, 2) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterLog(&sDatalog, 2, 2, 2, 5, (uint8_t*)&ui32Slow, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterLog(&sDatalog, 3, 3, 1, 10, (uint8_t*)&ui32Slow, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetTimebase(&sDatalog, 0, 5) == eDATALOG_ERROR_INVALID_PARAMETER);
+    CHECK(DataloggerSetTimebase(&sDatalog, 1, 10) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelTimebase(&sDatalog, 2, 1) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelTimebase(&sDatalog, 3, 1) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    for (t = 0; t < 120 && DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_RUNNING; t++)
+    {
+        ui16Fast = (uint16_t)t;
+        ui32Slow = 1000 + t;
+
+        if (t % 10 == 0)
+            DataloggerServiceTimebase(&sDatalog, 1);
+
+        DataloggerService(&sDatalog);
+    }
+
+    DataloggerStatemachine(&sDatalog);
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_DATA_READY);
+
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE && sView.ui32Count == 40);
+
+    for (k = 0; k < sView.ui32Count; k++)
+    {
+        CHECK(DataloggerViewGetSample(&sView, k) == 3 * k);
+        CHECK(DataloggerGetSampleTick(&sDatalog, 1, k, &ui32Tick) == eDATALOG_ERROR_NONE && ui32Tick == 3 * k);
+    }
+
+    // Divider 2 on a timebase of ratio 10: One sample every 20 base ticks
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 2) == eDATALOG_ERROR_NONE && sView.ui32Count == 5);
+
+    for (k = 0; k < sView.ui32Count; k++)
+    {
+        CHECK(DataloggerViewGetSample(&sView, k) == 1000 + 20 * k);
+        CHECK(DataloggerGetSampleTick(&sDatalog, 2, k, &ui32Tick) == eDATALOG_ERROR_NONE && ui32Tick == 20 * k);
+    }
+
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 3) == eDATALOG_ERROR_NONE && sView.ui32Count == 10);
+
+    for (k = 0; k < sView.ui32Count; k++)
+    {
+        CHECK(DataloggerViewGetSample(&sView, k) == 1000 + 10 * k);
+        CHECK(DataloggerGetSampleTick(&sDatalog, 3, k, &ui32Tick) == eDATALOG_ERROR_NONE && ui32Tick == 10 * k);
+    }
+
+    CHECK(DataloggerGetSampleTick(&sDatalog, 3, 10, &ui32Tick) != eDATALOG_ERROR_NONE);
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Export: A capture and a block streamed through a pipe are decoded and 
+ * converted back to the recorded values.
+ ***********************************************************************************/
+static void TestExportRoundTrip (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_SCALING sScaling = {eDATALOG_TYPE_INT, 0.1f, 5.0f};
+    tDATALOG_SCALING sAdcScaling = {eDATALOG_TYPE_UINT, 2.0f, 0.0f};
+    tDATALOG_CHANNEL_VIEW sView;
+    const uint8_t *pui8Desc;
+    const uint8_t *pui8Block;
+    int iPipe[2];
+    int16_t i16Var = 0;
+    uint16_t ui16Adc = 0;
+    uint8_t ui8Flags = 0;
+    double dValues[30], dDiff;
+    uint32_t ui32Len = 0, ui32Block;
+    ssize_t sRead;
+    uint32_t t, k;
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 0x10, 1, 1, 30, (uint8_t*)&i16Var, 2) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterPackedLog(&sDatalog, 0x20, 2, 2, 15, (uint8_t*)&ui16Adc, 2, 12) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterBitLog(&sDatalog, 0x30, 3, 1, 30, &ui8Flags, 1, 0x81) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelScaling(&sDatalog, 1, sScaling) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelScaling(&sDatalog, 2, sAdcScaling) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerInitLogger(&sDatalog, true) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerStart(&sDatalog) == eDATALOG_ERROR_NONE);
+
+    for (t = 0; t < 30; t++)
+    {
+        i16Var = (int16_t)(t * 300 - 4000);
+        ui16Adc = (uint16_t)((t * 397) & 0xFFF);
+        ui8Flags = (uint8_t)(t * 0x45);
+        DataloggerService(&sDatalog);
+    }
+
+    DataloggerStatemachine(&sDatalog);
+    CHECK(DataloggerGetCurrentState(&sDatalog) == eDLOGSTATE_DATA_READY);
+
+    // Capture plus the second half of channel 1 as a block record
+    CHECK(pipe(iPipe) == 0);
+    CHECK(DataloggerExportCapture(&sDatalog, iPipe[1]) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerExportBlock(iPipe[1], 1, 15, &sView.pui8Base[15 * sView.ui16Stride], 15 * sView.ui16Stride) == eDATALOG_ERROR_NONE);
+    close(iPipe[1]);
+
+    while ((sRead = read(iPipe[0], &ui8Image[ui32Len], sizeof(ui8Image) - ui32Len)) > 0)
+        ui32Len += (uint32_t)sRead;
+
+    close(iPipe[0]);
+
+    // Signed big endian samples, scaled
+    pui8Desc = _TestStreamView(ui8Image, 0, &sView, &sScaling);
+    CHECK(pui8Desc != NULL);
+
+    if (pui8Desc != NULL)
+    {
+        CHECK(_TestGet32(&pui8Desc[0]) == 0x10 && pui8Desc[4] == 1 && pui8Desc[11] == eDATALOG_CHKIND_PLAIN);
+        CHECK(sView.eEncoding == eDATALOG_ENCODING_BE && sView.ui32Count == 30);
+        CHECK(DataloggerConvertToDouble(&sView, &sScaling, dValues, 0, 30) == eDATALOG_ERROR_NONE);
+
+        // Gain 0.1 is not exact in single precision
+        for (k = 0; k < 30; k++)
+        {
+            dDiff = dValues[k] - (((int32_t)k * 300 - 4000) * 0.1 + 5.0);
+            CHECK(dDiff < 1e-3 && dDiff > -1e-3);
+        }
+    }
+
+    // Bit packed 12 bit samples, divider 2
+    pui8Desc = _TestStreamView(ui8Image, 1, &sView, &sScaling);
+    CHECK(pui8Desc != NULL);
+
+    if (pui8Desc != NULL)
+    {
+        CHECK(sView.eEncoding == eDATALOG_ENCODING_BITPACKED && sView.ui8BitWidth == 12 && sView.ui32Count == 15);
+        CHECK((pui8Desc[8] | (pui8Desc[9] << 8)) == 2 && sScaling.fGain == 2.0f);
+        CHECK(DataloggerConvertToDouble(&sView, &sScaling, dValues, 0, 15) == eDATALOG_ERROR_NONE);
+
+        for (k = 0; k < 15; k++)
+            CHECK(dValues[k] == 2.0 * ((2 * k * 397) & 0xFFF));
+    }
+
+    // Bits 0 and 7 of the flags
+    pui8Desc = _TestStreamView(ui8Image, 2, &sView, &sScaling);
+    CHECK(pui8Desc != NULL);
+
+    if (pui8Desc != NULL)
+    {
+        CHECK(pui8Desc[11] == eDATALOG_CHKIND_BIT && sView.ui8BitWidth == 2 && sView.ui32Count == 30);
+
+        for (k = 0; k < 30; k++)
+        {
+            ui8Flags = (uint8_t)(k * 0x45);
+            CHECK(DataloggerViewGetSample(&sView, k) == ((ui8Flags & 1) | ((ui8Flags >> 6) & 2)));
+        }
+    }
+
+    // The block record follows the capture and its CRC trailer
+    CHECK(DataloggerGetChannelView(&sDatalog, &sView, 1) == eDATALOG_ERROR_NONE);
+    ui32Block = _TestGet32(&ui8Image[12]) + DataloggerExportTrailer(&sDatalog, NULL);
+
+    for (k = 0; k < 3; k++)
+        ui32Block += _TestGet32(&ui8Image[DATALOGGER_EXPORT_FILE_HEADER_SIZE + k * DATALOGGER_EXPORT_CHANNEL_HEADER_SIZE + 16]);
+
+    CHECK(ui32Len == ui32Block + DATALOGGER_EXPORT_BLOCK_HEADER_SIZE + 15 * sView.ui16Stride);
+
+    if (ui32Len == ui32Block + DATALOGGER_EXPORT_BLOCK_HEADER_SIZE + 15 * sView.ui16Stride)
+    {
+        pui8Block = &ui8Image[ui32Block];
+        CHECK(memcmp(pui8Block, "DLBK", 4) == 0 && pui8Block[4] == 1);
+        CHECK(_TestGet32(&pui8Block[8]) == 15 && _TestGet32(&pui8Block[12]) == 15 * sView.ui16Stride);
+
+        for (k = 0; k < 15; k++)
+            CHECK((int16_t)((pui8Block[16 + 2 * k] << 8) | pui8Block[17 + 2 * k]) == (int16_t)((15 + k) * 300 - 4000));
+    }
+
+    DataloggerReset(&sDatalog);
+}
+
+//===================================================================================
+/********************************************************************************//**
+ * \brief Black box: A frozen ring capture is persisted to a storage file and 
+ * recovered after a "reboot" with its reason and the last samples, oldest first.
+ ***********************************************************************************/
+static void TestBlackBox (void)
+{
+    tDATALOGGER sDatalog = tDATALOGGER_DEFAULTS;
+    tDATALOGGER_CALLBACKS sCallbacks = tDATALOGGER_CALLBACKS_DEFAULTS;
+    tDATALOG_SCALING sScaling = {eDATALOG_TYPE_INT, 0.5f, 0.0f};
+    tDATALOG_STORAGE sStorage = tDATALOG_STORAGE_DEFAULTS;
+    tDATALOG_STORAGE_FILE sFile = tDATALOG_STORAGE_FILE_DEFAULTS;
+    tDATALOG_BLACKBOX sBB, sRebooted;
+    tDATALOG_BLACKBOX_IMAGE sImage;
+    tDATALOG_CHANNEL_VIEW sView;
+    const uint8_t *pui8Desc;
+    const char *pcPath = "DataloggerTest.bin";
+    uint32_t ui32Var = 0;
+    int16_t i16Var = 0;
+    float fValues[20];
+    uint32_t t, k;
+
+    remove(pcPath);
+    CHECK(DataloggerStorageFileOpen(&sStorage, &sFile, pcPath, 4096) == eDATALOG_ERROR_NONE);
+
+    DataloggerInit(&sDatalog, sCallbacks);
+    CHECK(DataloggerRegisterLog(&sDatalog, 0x100, 1, 3, 10, (uint8_t*)&ui32Var, 4) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerRegisterLog(&sDatalog, 0x200, 2, 1, 20, (uint8_t*)&i16Var, 2) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerSetChannelScaling(&sDatalog, 2, sScaling) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerBlackBoxInit(&sBB, &sDatalog, &sStorage, 512, 3000) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerBlackBoxRecover(&sBB, &sImage) == eDATALOG_ERROR_NO_DATA);
+    CHECK(DataloggerBlackBoxStart(&sBB) == eDATALOG_ERROR_NONE);
+
+    for (t = 0; t < 200; t++)
+    {
+        ui32Var = t;
+        i16Var = (int16_t)(-(int32_t)t);
+        DataloggerService(&sDatalog);
+    }
+
+    CHECK(DataloggerBlackBoxFreeze(&sBB, 0xBEEF) == eDATALOG_ERROR_NONE);
+
+    for (k = 0; k < 1000 && sBB.eState != eBLACKBOX_DONE; k++)
+    {
+        DataloggerStatemachine(&sDatalog);
+        CHECK(DataloggerBlackBoxService(&sBB) == eDATALOG_ERROR_NONE);
+    }
+
+    CHECK(sBB.eState == eBLACKBOX_DONE);
+    DataloggerStorageFileClose(&sFile);
+    DataloggerReset(&sDatalog);
+
+    // Reboot: Only the storage file is left
+    CHECK(DataloggerStorageFileOpen(&sStorage, &sFile, pcPath, 4096) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerBlackBoxInit(&sRebooted, &sDatalog, &sStorage, 512, 3000) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerBlackBoxRecover(&sRebooted, &sImage) == eDATALOG_ERROR_NONE);
+    CHECK(sImage.ui32Reason == 0xBEEF && sImage.ui32Length <= sizeof(ui8Image));
+
+    if (sImage.ui32Length <= sizeof(ui8Image))
+    {
+        CHECK(DataloggerBlackBoxRead(&sRebooted, 0, ui8Image, sImage.ui32Length) == eDATALOG_ERROR_NONE);
+
+        // Divider 3: The last 10 samples were taken at ticks 171, 174, ... 198
+        pui8Desc = _TestStreamView(ui8Image, 0, &sView, &sScaling);
+        CHECK(pui8Desc != NULL);
+
+        if (pui8Desc != NULL)
+        {
+            CHECK(_TestGet32(&pui8Desc[0]) == 0x100 && pui8Desc[11] == eDATALOG_CHKIND_PLAIN);
+            CHECK(sView.ui32Count == 10 && _TestGet32(&pui8Desc[28]) == 171);
+
+            for (k = 0; k < sView.ui32Count; k++)
+                CHECK(DataloggerViewGetSample(&sView, k) == 171 + 3 * k);
+        }
+
+        pui8Desc = _TestStreamView(ui8Image, 1, &sView, &sScaling);
+        CHECK(pui8Desc != NULL);
+
+        if (pui8Desc != NULL)
+        {
+            CHECK(sView.ui32Count == 20 && _TestGet32(&pui8Desc[28]) == 180);
+            CHECK(sScaling.eType == eDATALOG_TYPE_INT && sScaling.fGain == 0.5f);
+            CHECK(DataloggerConvertToFloat(&sView, &sScaling, fValues, 0, 20) == eDATALOG_ERROR_NONE);
+
+            for (k = 0; k < 20; k++)
+                CHECK(fValues[k] == -0.5f * (float)(180 + k));
+        }
+    }
+
+    // A corrupted image is not recovered
+    ui8Image[100] ^= 0xFF;
+    CHECK(sStorage.Write(512 + DATALOGGER_BLACKBOX_COMMIT_SIZE + 100, &ui8Image[100], 1, sStorage.pvCtx) == eDATALOG_ERROR_NONE);
+    CHECK(DataloggerBlackBoxRecover(&sRebooted, &sImage) == eDATALOG_ERROR_NO_DATA);
+
+    DataloggerStorageFileClose(&sFile);
+    remove(pcPath);
+}
+
+/************************************************************************************
+ * Function definitions
+ ***********************************************************************************/
+int main(void)
+{
+    TestCaptureBuffers();
+    TestSegments();
+    TestDividerMarkers();
+    TestBlockCrc();
+    TestCommittedView();
+    TestGather();
+    TestReregister();
+    TestRingUnroll();
+    TestHistogram();
+    TestDecimation();
+    TestDecimationRateChange();
+    TestReadout();
+    TestFlashLogRecovery();
+    TestBitChannels();
+    TestPackedSignExtension();
+    TestShardMerge();
+    TestReplay();
+    TestTimebaseTicks();
+    TestExportRoundTrip();
+    TestBlackBox();
+
+    printf("%s: %u failed checks\n", ui32UnitTestFailures ? "FAILED" : "PASSED", (unsigned)ui32UnitTestFailures);
+
+    return ui32UnitTestFailures ? 1 : 0;
+}
+// EOF
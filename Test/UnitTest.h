@@ -0,0 +1,34 @@
+/********************************************************************************//**
+ * \file UnitTest.h
+ * \author Roman Holderried
+ *
+ * \brief Check macro of the behaviour tests.
+ *
+ * <b> History </b>
+ *      - 2026-10-19 - File creation.
+ *                     
+ ***********************************************************************************/
+#ifndef _UNITTEST_H_
+#define _UNITTEST_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+/************************************************************************************
+ * Defines
+ ***********************************************************************************/
+/** Counts and reports a failed condition, the test continues */
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        ui32UnitTestFailures++; \
+    } \
+} while (0)
+
+/************************************************************************************
+ * Global variables
+ ***********************************************************************************/
+extern uint32_t ui32UnitTestFailures;
+
+#endif //_UNITTEST_H_
+// EOF